@@ -3,63 +3,145 @@
 
 #include "particles_system.hpp"
 
+#include <tuesday/utility/triple_buffer.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+
+// Instance positions are uploaded as halves (the scene spans a few units),
+// colors stay 8-bit. model_data::update converts positions in bulk rather
+// than through this specialization, which sets the mirror type.
+template <> struct tue::gfx::gpu_format_fn<Position> {
+    constexpr auto operator()(const Position &p) const noexcept {
+        return to_half(std::array{p.value.x, p.value.y, p.value.z});
+    }
+};
+
+template <> struct tue::gfx::gpu_format_fn<Color> {
+    constexpr glm::u8vec3 operator()(const Color &c) const noexcept {
+        return c.value;
+    }
+};
+
 class demo1_scene : public base_scene {
   public:
     static constexpr auto init_radius = 6.F;
     static constexpr auto part_radius = 0.02F;
-    static constexpr auto part_mesh = cube_mesh(part_radius);
+    static constexpr auto part_vertices = cube_vertices(part_radius);
+    static constexpr auto part_indices = cube_indices();
 
+    /// Per-instance attributes, interleaved into one stream.
+    struct instance_vertex {
+        tue::gfx::gpu_format_t<Position> pos;
+        tue::gfx::gpu_format_t<Color> color;
+    };
+    static_assert(tue::gfx::vertex_layout_matches<instance_vertex>(
+                      vert_source_inst, 1),
+                  "instance_vertex does not match the shader inputs");
+    static_assert(std::is_same_v<decltype(instance_vertex::pos),
+                                 tue::gfx::half3>,
+                  "model_data::update converts positions to halves");
+
+    /// What rendering needs from the simulation, published after steps
+    /// (possibly on another thread, see base_app::threaded).
+    struct snapshot {
+        std::vector<Position> prev; // before the latest step
+        std::vector<Position> pos;
+        std::vector<Color> color;
+    };
+
+    /// GPU side, touched by the render thread only.
     struct model_data {
-        struct attr_data {
-            tue::gfx::vertex_attrib_format attr{};
-            tue::gfx::vertex_buffer vbo{};
-            std::size_t size{0};
-            const void *data{nullptr};
-        };
-
-        attr_data attrs[2];
-
-        void reset(EntityRegistry &reg) {
-            const auto &pos = reg.use_component<Position>();
-            const auto &clr = reg.use_component<Color>();
-
-            attrs[0] = attr_data{
-                tue::gfx::vertex_attrib_format_for<glm::vec3>,
-                tue::gfx::create_vertex_buffer_for<glm::vec3>(pos.size(),
-                                                              GL_STREAM_DRAW),
-                pos.size() * sizeof(glm::vec3),
-                pos.data(),
-            };
-            attrs[1] = attr_data{
-                tue::gfx::vertex_attrib_format_for<glm::u8vec3>,
-                tue::gfx::create_vertex_buffer_for<glm::u8vec3>(clr.size(),
-                                                                GL_STREAM_DRAW),
-                clr.size() * sizeof(glm::u8vec3),
-                clr.data(),
-            };
+        std::vector<float> positions; // interpolated, x y z per instance
+        std::vector<std::uint16_t> halves;
+        std::vector<instance_vertex> instances;
+        tue::gfx::vertex_buffer vbo{};
+
+        void update(const snapshot &s, float alpha) {
+            const auto n = s.pos.size();
+            positions.resize(3 * n);
+            for (std::size_t i{0}; i < n; ++i) {
+                const glm::vec3 x0 = s.prev[i];
+                const glm::vec3 x1 = s.pos[i];
+                const glm::vec3 p = x0 + (x1 - x0) * alpha;
+                positions[3 * i + 0] = p.x;
+                positions[3 * i + 1] = p.y;
+                positions[3 * i + 2] = p.z;
+            }
+
+            // one pass over all of them, eight at a time with F16C
+            halves.resize(positions.size());
+            tue::gfx::float_to_half(positions, halves);
+
+            instances.resize(n);
+            for (std::size_t i{0}; i < n; ++i) {
+                auto &v = instances[i];
+                std::copy_n(halves.begin() + 3 * i, 3, v.pos.bits.begin());
+                v.color = tue::gfx::to_gpu_format(s.color[i]);
+            }
+
+            const auto size = instances.size() * sizeof(instance_vertex);
+            glNamedBufferData(vbo.id, size, nullptr, GL_STREAM_DRAW);
+            glNamedBufferSubData(vbo.id, 0, size, instances.data());
         }
     };
 
+    /// A quad under the particles, at y = 0 where they bounce.
+    static constexpr auto ground_extent = 2 * init_radius;
+    static constexpr std::array ground_vertices{
+        glm::vec3{-ground_extent, 0, -ground_extent},
+        glm::vec3{+ground_extent, 0, -ground_extent},
+        glm::vec3{+ground_extent, 0, +ground_extent},
+        glm::vec3{+ground_extent, 0, +ground_extent},
+        glm::vec3{-ground_extent, 0, +ground_extent},
+        glm::vec3{-ground_extent, 0, -ground_extent},
+    };
+
+    /// The ground goes through the app's upload queue (on its worker
+    /// context when there is one) and is drawn from the first frame both
+    /// of its buffers have been handed over.
+    struct ground_data {
+        std::uint64_t mesh_ticket{0};
+        std::uint64_t inst_ticket{0};
+        tue::gfx::vertex_buffer mesh{};
+        tue::gfx::vertex_buffer inst{};
+        tue::gfx::vertex_array vao{};
+    };
+
     std::size_t part_count{0};
     tue::gfx::vertex_array vao{};
-    tue::gfx::vertex_buffer vbo_one{};
+    tue::gfx::mesh_batch<glm::vec3> m_meshes;
+    tue::gfx::mesh_range m_cube{};
+    tue::gfx::indirect_commands m_draws;
     tue::gfx::shader_program shader{};
     model_data m_data;
+    ground_data m_ground;
 
   public:
-    void cleaup() {
-        for (auto &a : m_data.attrs) {
-            delete_vertex_buffer(a.vbo);
+    void cleaup(render_context &ctx) {
+        for (auto *vbo : {&m_ground.mesh, &m_ground.inst}) {
+            ctx.state.forget_buffer(vbo->id);
+            delete_vertex_buffer(*vbo);
         }
-        delete_vertex_buffer(vbo_one);
+        ctx.state.forget_vertex_array(m_ground.vao.id);
+        delete_vertex_array(m_ground.vao);
+        ctx.state.forget_buffer(m_data.vbo.id);
+        delete_vertex_buffer(m_data.vbo);
+        m_draws.release(ctx.state);
+        m_meshes.release(ctx.state);
+        ctx.state.forget_vertex_array(vao.id);
         delete_vertex_array(vao);
+        ctx.forget(shader);
         delete_shader(shader);
     }
 
     void reset() override {
+        tue_profile_scope("demo.scene.reset");
 
         part_count = 10'000U;
         m_reg = {};
+        m_prev.clear();
 
         m_reg.make_system<PhysicsSystem>(m_reg);
         m_reg.make_system<CollisionSystem>(m_reg);
@@ -71,55 +153,143 @@ class demo1_scene : public base_scene {
                          Color{glm::vec3{255.F} * glm::ballRand(1.F)}, Force{},
                          Velocity{});
         }
+    }
 
-        m_data.reset(m_reg);
+    void update(delta_time dt_) override {
+        const auto &pos = m_reg.use_component<Position>();
+        m_prev.assign(pos.data(), pos.data() + pos.size());
 
-        const GLuint one_binding_index = 0;
-        vao = tue::gfx::create_vertex_array();
+        m_reg.use_system<PhysicsSystem>().run(dt_.count());
+        m_reg.use_system<CollisionSystem>().run(dt_.count());
+    }
 
-        vbo_one = tue::gfx::create_vertex_buffer(part_mesh, GL_STATIC_DRAW);
-        bind_buffer(vao, one_binding_index, vbo_one);
-        auto one_fmt = tue::gfx::vertex_attrib_format_for<glm::vec3>;
-        one_fmt.index = one_binding_index;
-        bind_attrib(vao, one_binding_index, one_fmt);
+    void publish() override {
+        tue_profile_scope("demo.scene.publish");
+        const auto &pos = m_reg.use_component<Position>();
+        const auto &clr = m_reg.use_component<Color>();
 
-        glVertexArrayBindingDivisor(vao.id, one_binding_index, 0);
+        // the buffers are reused: no allocation once they have grown
+        auto &s = m_frames.write_buffer();
+        s.pos.assign(pos.data(), pos.data() + pos.size());
+        s.color.assign(clr.data(), clr.data() + clr.size());
+        if (m_prev.size() == s.pos.size()) {
+            s.prev.assign(m_prev.begin(), m_prev.end());
+        }
+        else {
+            s.prev = s.pos;
+        }
+        m_frames.publish();
+    }
+
+    void render(render_context &ctx) override {
+        if (!vao) {
+            init_gpu(ctx);
+        }
+        render_ground(ctx);
 
-        auto abi = one_binding_index + 1;
-        for (auto &a : m_data.attrs) {
-            bind_buffer(vao, abi, a.vbo);
-            a.attr.index = abi;
-            bind_attrib(vao, abi, a.attr);
-            glVertexArrayBindingDivisor(vao.id, abi, 1);
-            abi++;
+        m_frames.update();
+        const auto &s = m_frames.read_buffer();
+        if (s.pos.empty()) {
+            return;
         }
 
-        shader = tue::gfx::make_shader(vert_source_inst, frag_source);
-    }
+        {
+            tue_profile_scope("demo.scene.gather_instances");
+            m_data.update(s, ctx.alpha);
+        }
 
-    void update(delta_time dt_) override {
-        m_reg.use_system<PhysicsSystem>().update(dt_.count());
-        m_reg.use_system<CollisionSystem>().update(dt_.count());
-    }
+        // one command per mesh of the batch: all of them go in one call
+        m_draws.clear();
+        m_draws.push(m_cube, static_cast<GLuint>(s.pos.size()));
+        m_draws.upload();
 
-    void render(render_context &ctx) override {
         ctx.use(shader);
-        ctx.use(vao);
+        m_draws.draw(ctx.state, vao, GL_TRIANGLES, m_meshes.indices().type);
+    }
 
-        for (auto &a : m_data.attrs) {
-            glNamedBufferData(a.vbo.id, a.size, nullptr, GL_STREAM_DRAW);
-            glNamedBufferSubData(a.vbo.id, 0, a.size, a.data);
+  private:
+    void render_ground(render_context &ctx) {
+        if (!ctx.uploads) {
+            return;
+        }
+
+        auto &uploads = ctx.uploads();
+        if (m_ground.mesh_ticket == 0) {
+            const std::array inst{instance_vertex{
+                tue::gfx::to_gpu_format(Position{glm::vec3{0}}),
+                tue::gfx::to_gpu_format(Color{glm::u8vec3(40, 40, 48)}),
+            }};
+            m_ground.mesh_ticket = uploads.upload(std::span{ground_vertices});
+            m_ground.inst_ticket = uploads.upload(std::span{inst});
+        }
+
+        if (!m_ground.vao) {
+            // the ground is all this scene uploads: every buffer is its own
+            uploads.poll([&](const tue::gfx::uploaded_buffer &b) {
+                auto &vbo = b.ticket == m_ground.mesh_ticket ? m_ground.mesh
+                                                             : m_ground.inst;
+                vbo = b.as_vertex_buffer();
+            });
+            if (!m_ground.mesh || !m_ground.inst) {
+                return; // still uploading
+            }
+
+            m_ground.vao = tue::gfx::create_vertex_array();
+            bind_buffer(m_ground.vao, 0, m_ground.mesh);
+            auto fmt = tue::gfx::vertex_attrib_format_for<glm::vec3>;
+            bind_attrib(m_ground.vao, 0, fmt);
+            bind_buffer(m_ground.vao, 1, m_ground.inst);
+            tue::gfx::bind_vertex_layout<instance_vertex>(m_ground.vao, 1, 1,
+                                                          1);
         }
 
-        glDrawArraysInstanced(GL_TRIANGLES, 0, part_mesh.size(), part_count);
+        ctx.submit({
+            .program = shader,
+            .vao = m_ground.vao,
+            .mode = GL_TRIANGLES,
+            .count = static_cast<GLsizei>(ground_vertices.size()),
+        });
     }
 
-  private:
+    void init_gpu(render_context &ctx) {
+        const GLuint one_binding_index = 0;
+        vao = tue::gfx::create_vertex_array();
+
+        m_cube =
+            m_meshes.add(std::span{part_vertices}, std::span{part_indices});
+        m_meshes.upload(ctx.state);
+        m_meshes.bind(vao, one_binding_index);
+        auto one_fmt = tue::gfx::vertex_attrib_format_for<glm::vec3>;
+        one_fmt.index = one_binding_index;
+        bind_attrib(vao, one_binding_index, one_fmt);
+
+        glVertexArrayBindingDivisor(vao.id, one_binding_index, 0);
+
+        // sized by the first upload
+        m_data.vbo = tue::gfx::create_vertex_buffer_for<instance_vertex>(
+            0, GL_STREAM_DRAW);
+
+        const GLuint inst_binding_index = 1;
+        bind_buffer(vao, inst_binding_index, m_data.vbo);
+        tue::gfx::bind_vertex_layout<instance_vertex>(vao, inst_binding_index,
+                                                      1, 1);
+
+        shader = tue::gfx::make_shader(vert_source_inst, frag_source);
+    }
+
+    // simulation side
     EntityRegistry m_reg;
+    std::vector<Position> m_prev;
+
+    tue::triple_buffer<snapshot> m_frames;
 };
 
-int main() {
+int main(int argc, char *argv[]) {
     demo_app app;
+    if (!app.parse_args(argc, argv)) {
+        return 1;
+    }
+
     demo1_scene scene;
     app.set_scene(scene);
     app.run();
@@ -117,6 +117,7 @@ using EntityRegistry = tue::ecs::entity_registry<Entity, EntityTraits>;
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 struct PhysicsSystem : public tue::ecs::basic_system<PhysicsSystem, Entity> {
+    static constexpr const char *profile_name = "demo.physics_system.update";
 
     EntityRegistry &m_reg;
 
@@ -149,6 +150,8 @@ template <> struct tue::ecs::system_feature_tseq<PhysicsSystem> {
 
 struct CollisionSystem
     : public tue::ecs::basic_system<CollisionSystem, Entity> {
+    static constexpr const char *profile_name =
+        "demo.collision_system.update";
 
     EntityRegistry &m_reg;
 
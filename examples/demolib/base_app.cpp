@@ -1,7 +1,106 @@
 #include "base_app.hpp"
 #include "helpers.hpp"
 
+#include <charconv>
+#include <fstream>
+#include <optional>
 #include <print>
+#include <string_view>
+#include <system_error>
+#include <thread>
+
+static void print(std::string_view name, const tue::histogram_summary &s) {
+    const auto ms = [](std::uint64_t ns) { return double(ns) * 1e-6; };
+    std::println("{}: n={} p50={:.2f} p95={:.2f} p99={:.2f} max={:.2f} ms",
+                 name, s.count, ms(s.p50), ms(s.p95), ms(s.p99), ms(s.max));
+}
+
+/// All of `s` as a number, or nothing (no trailing characters, no sign for
+/// unsigned types).
+template <class T> static std::optional<T> parse_number(std::string_view s) {
+    T v{};
+    const auto *end = s.data() + s.size();
+    const auto [p, ec] = std::from_chars(s.data(), end, v);
+    if (ec != std::errc{} || p != end) {
+        return std::nullopt;
+    }
+    return v;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+bool base_app::parse_args(int argc, char *argv[]) {
+    for (int i{1}; i < argc; ++i) {
+        const std::string_view arg{argv[i]};
+        const auto value = [&](std::string_view opt) -> const char * {
+            if (arg.starts_with(opt) && arg.size() > opt.size() &&
+                arg[opt.size()] == '=') {
+                return argv[i] + opt.size() + 1;
+            }
+            return nullptr;
+        };
+
+        if (arg == "--headless") {
+            headless = true;
+        }
+        else if (arg == "--threaded") {
+            threaded = true;
+        }
+        else if (arg == "--on-demand") {
+            on_demand = true;
+        }
+        else if (arg == "--latency") {
+            latency = true;
+        }
+        else if (arg == "--pace") {
+            pace = true;
+        }
+        else if (const auto *v = value("--swap-interval")) {
+            const auto n = parse_number<int>(v);
+            if (!n) {
+                std::println(stderr, "--swap-interval: not an integer: '{}'",
+                             v);
+                return false;
+            }
+            wnd_attrs.swap.frames = *n;
+        }
+        else if (const auto *v = value("--frames")) {
+            const auto n = parse_number<std::size_t>(v);
+            if (!n || *n == 0) {
+                std::println(stderr, "--frames: not a positive integer: '{}'",
+                             v);
+                return false;
+            }
+            frames = *n;
+        }
+        else if (const auto *v = value("--stats-csv")) {
+            stats_csv = v;
+        }
+        else if (const auto *v = value("--stats-json")) {
+            stats_json = v;
+        }
+        else if (const auto *v = value("--trace")) {
+            trace_json = v;
+        }
+        else {
+            std::println(stderr,
+                         "unknown argument: {}\n"
+                         "options: --headless --threaded --on-demand "
+                         "--latency --pace --swap-interval=N --frames=N "
+                         "--stats-csv=PATH --stats-json=PATH --trace=PATH",
+                         arg);
+            return false;
+        }
+    }
+
+    if (pace && wnd_attrs.swap.frames == 0) {
+        // swaps would return as soon as drawn, and the pacer would chase
+        // its own frame times instead of the display
+        std::println(stderr, "--pace needs vsync, not --swap-interval=0");
+        return false;
+    }
+    return true;
+}
 
 bool base_app::done() const {
     return false;
@@ -23,7 +122,7 @@ void base_app::keyboard(tue::wsi::window &w, tue::wsi::keyboard_event e) {
         w.toggle_fullscreen();
     }
     else if (e.pressed(key_code::space)) {
-        reset();
+        request_reset();
     }
     else {
         std::println("keyboard: code={}", (int)e.code);
@@ -38,8 +137,22 @@ void base_app::mouse([[maybe_unused]] tue::wsi::window &w,
 }
 
 void base_app::run() {
-    m_wsi = tue::wsi::connect();
+    if (!trace_json.empty()) {
+        tue::profile::set_thread_name("main");
+        tue::profile::set_enabled(true);
+    }
+
+    if (frames > 0) {
+        wnd_attrs.swap.frames = 0; // as fast as possible, not at vblanks
+    }
+    if (pace && wnd_attrs.swap.frames == 0) {
+        std::println(stderr, "pace ignored: it needs vsync");
+        pace = false;
+    }
+
+    m_wsi = tue::wsi::connect({.headless = headless});
     m_wnd = m_wsi.make_window(wnd_attrs);
+    m_wnd.set_queued(true);
     watch(m_wnd);
 
     m_wnd.open();
@@ -57,71 +170,390 @@ void base_app::run() {
     do_reset();
     resize(m_wnd, {.size = m_wnd.get_attrs().size});
 
-    time_point t0 = clock_type::now();
-    time_point ti = t0;
-    delta_time dt_stat = delta_time::zero();
+    const auto draw_period = std::chrono::duration_cast<duration>(draw_rate);
+    m_step_period = std::chrono::duration_cast<duration>(step_rate);
+    tue_assert(m_step_period > duration::zero());
 
-    while (!done() && !m_wnd.should_close()) {
-        auto t = clock_type::now();
-        auto dt = delta_time{t - ti};
-        ti = t;
+    const time_point t0 = clock_type::now();
+    time_point t_report = t0 + std::chrono::seconds{1};
+    m_t_steps = t0;
+    m_acc = duration::zero();
 
-        do_step();
+    const auto report_if_due = [&](time_point t) {
+        constexpr std::chrono::seconds window{1};
+        if (t >= t_report) {
+            // skips the windows an on-demand loop slept through
+            t_report += (t - t_report) / window * window + window;
+            report_window(delta_time{t - t0}.count());
+        }
+    };
 
-        if (do_draw()) {
+    const auto frame = [&](time_point t, bool paced) {
+        if (!paced || clock_type::now() >= m_t_next_draw) {
+            // input is polled last thing before drawing, so a paced frame
+            // draws what arrived while it waited for its start
+            const auto t_start = clock_type::now();
             m_wsi.poll_events();
-            m_wnd.swap_buffers();
+            m_wnd.dispatch_events();
+            do_draw();
+            // all the work before the swap: the events, the CPU side of
+            // drawing, and the GPU's (the latest read back, lagging a few
+            // frames). The two overlap, so the sum errs on the early side
+            const auto gpu = std::chrono::duration_cast<duration>(
+                std::chrono::duration<double, std::milli>{m_gpu.frame_ms()});
+            m_pacer.add_work(clock_type::now() - t_start + gpu);
+            do_swap();
+        }
+        report_if_due(t);
+    };
+
+    if (frames > 0) {
+        // simulated time advances by exactly `draw_rate` per frame
+        std::size_t drawn{0};
+        for (std::size_t i{1}; i <= frames; ++i) {
+            if (done() || m_wnd.should_close()) {
+                break;
+            }
+            do_steps(t0 + draw_period * static_cast<duration::rep>(i));
+            m_alpha = static_cast<float>(m_acc.count()) /
+                      static_cast<float>(m_step_period.count());
+            frame(clock_type::now(), false);
+            ++drawn;
+        }
+        print_totals(drawn);
+    }
+    else if (on_demand) {
+        while (!done() && !m_wnd.should_close()) {
+            // sleeps until input or a wake-up; with a redraw pending, at
+            // most until the draw rate allows the next frame
+            m_wsi.wait_events_until(m_redraw_requested ? m_t_next_draw
+                                                       : time_point::max());
+            if (m_wnd.dispatch_events() > 0) {
+                m_redraw_requested = true;
+            }
+            reset_if_requested();
+
+            const auto t = clock_type::now();
+            if (m_redraw_requested && t >= m_t_next_draw) {
+                m_redraw_requested = false;
+                do_draw();
+                do_swap();
+            }
+            // not woken up for it: an idle second has nothing to report
+            report_if_due(t);
+        }
+    }
+    else if (threaded) {
+        // joined at the end of the block, before anything it uses is gone
+        std::jthread sim{[this](std::stop_token stop) {
+            tue::profile::set_thread_name("sim");
+            while (!stop.stop_requested()) {
+                const auto t = clock_type::now();
+                tue::precise_sleep_until(t + do_steps(t));
+            }
+        }};
+
+        while (!done() && !m_wnd.should_close()) {
+            frame(clock_type::now(), true);
+            tue::precise_sleep_until(m_t_next_draw);
         }
+    }
+    else {
+        while (!done() && !m_wnd.should_close()) {
+            const auto t = clock_type::now();
+            const auto next_step = t + do_steps(t);
+            m_alpha = static_cast<float>(m_acc.count()) /
+                      static_cast<float>(m_step_period.count());
+            frame(t, true);
 
-        dt_stat += dt;
-        if (dt_stat > delta_time{1}) {
-            dt_stat -= delta_time{1};
-            std::println("step:{:.2f}; draw:{:.2f}", stat.step_fps(),
-                         stat.draw_fps());
+            // nothing is due before the next step or draw
+            tue::precise_sleep_until(std::min(next_step, m_t_next_draw));
         }
     }
+
+    export_totals();
+    export_trace();
+
+    for (const auto &q : m_latency_queries) {
+        m_free_queries.push_back(q.query);
+    }
+    m_latency_queries.clear();
+    if (!m_free_queries.empty()) {
+        glDeleteQueries(static_cast<GLsizei>(m_free_queries.size()),
+                        m_free_queries.data());
+        m_free_queries.clear();
+    }
+
+    m_uploads.reset(); // joins the upload thread, which uses m_worker
+    m_worker = {};
+}
+
+tue::gfx::upload_queue &base_app::uploads() {
+    if (!m_uploads) {
+        // one more GL context and thread, for apps that ask only
+        m_worker = m_wsi.make_worker_context();
+        if (m_worker) {
+            m_uploads.emplace([this] { m_worker.make_current(); },
+                              [this] { m_worker.release(); });
+        }
+        else {
+            m_uploads.emplace();
+        }
+    }
+    return *m_uploads;
 }
 
 void base_app::do_reset() {
-    stat = {};
+    stat.reset();
     m_t_init = clock_type::now();
-    m_t_step = m_t_init;
     m_t_draw = m_t_init;
+    m_t_next_draw = m_t_init;
 
     reset();
+    publish();
 }
 
-bool base_app::do_step() {
+void base_app::reset_if_requested() {
+    if (m_reset_requested.exchange(false)) {
+        reset();
+        publish();
+    }
+}
+
+base_app::duration base_app::do_steps(time_point t) {
+    reset_if_requested();
+
+    // fixed steps for the time elapsed, so the simulation does not
+    // depend on the frame rate
+    m_acc += t - m_t_steps;
+    m_t_steps = t;
+
+    int n{0};
+    for (; m_acc >= m_step_period; ++n) {
+        if (n == max_catchup_steps) {
+            stat.dropped_steps.fetch_add(
+                static_cast<std::uint64_t>(m_acc / m_step_period),
+                std::memory_order_relaxed);
+            m_acc %= m_step_period;
+            break;
+        }
+        do_step();
+        m_acc -= m_step_period;
+    }
+    if (n > 0) {
+        publish();
+    }
+
+    return m_step_period - m_acc;
+}
+
+void base_app::do_step() {
     auto t = clock_type::now();
-    auto dt = delta_time{t - m_t_step};
-    step(dt);
+    {
+        tue_profile_scope("demo.base_app.step");
+        step(step_rate);
+    }
     auto t_frame = clock_type::now();
     stat.step.add_frame(delta_time{t_frame - t});
-    m_t_step = t;
-    return true;
 }
 
-bool base_app::do_draw() {
+void base_app::do_draw() {
     auto t = clock_type::now();
-    auto dt = delta_time{t - m_t_draw};
+    m_input_drawn = std::exchange(m_input_pending, {});
 
-    if (dt < draw_rate) {
-        return false;
+    const bool gpu_fresh = m_gpu.begin_frame();
+    {
+        tue_profile_scope("demo.base_app.draw");
+        draw();
     }
-
-    draw();
+    m_gpu.end_frame();
     auto t_frame = clock_type::now();
 
     m_t_draw = t;
+    m_t_next_draw = t + std::chrono::duration_cast<duration>(draw_rate);
     stat.draw.add_frame(delta_time{t_frame - t});
-    return true;
+    if (gpu_fresh) {
+        stat.gpu.add_frame(delta_time{m_gpu.frame_ms() * 1e-3});
+    }
+}
+
+void base_app::do_swap() {
+    {
+        tue_profile_scope("demo.base_app.swap_buffers");
+        m_wnd.swap_buffers();
+    }
+    if (pace) {
+        const auto t = clock_type::now();
+        m_pacer.add_swap(t);
+        m_t_next_draw = m_pacer.frame_start(t);
+    }
+    if (!latency) {
+        return;
+    }
+
+    check_latency_queries();
+
+    const auto input = std::exchange(m_input_drawn, {});
+    if (input == tue::wsi::event_time{}) {
+        return;
+    }
+    stat.input_swap.add_frame(delta_time{clock_type::now() - input});
+    if (!m_gpu.enabled()) {
+        return; // no timer queries
+    }
+
+    // a few frames in flight at most: if the GPU is further behind, the
+    // oldest sample is dropped rather than growing the list
+    constexpr std::size_t max_queries = 8;
+    if (m_latency_queries.size() == max_queries) {
+        m_free_queries.push_back(m_latency_queries.front().query);
+        m_latency_queries.erase(m_latency_queries.begin());
+    }
+    if (m_free_queries.empty()) {
+        m_free_queries.push_back(0);
+        glGenQueries(1, &m_free_queries.back());
+    }
+    const auto query = m_free_queries.back();
+    m_free_queries.pop_back();
+
+    // the GPU time once it has executed everything up to the swap
+    glQueryCounter(query, GL_TIMESTAMP);
+    m_latency_queries.push_back({query, input});
+}
+
+void base_app::check_latency_queries() {
+    // timestamps complete in submission order
+    std::size_t n{0};
+    for (const auto &q : m_latency_queries) {
+        if (!tue::gfx::query_available(q.query)) {
+            break;
+        }
+        if (n == 0) {
+            m_gpu_clock.sync();
+        }
+        const auto done = m_gpu_clock.to_cpu(tue::gfx::query_result(q.query));
+        stat.input_gpu.add_frame(delta_time{done - q.input});
+        m_free_queries.push_back(q.query);
+        ++n;
+    }
+    m_latency_queries.erase(m_latency_queries.begin(),
+                            m_latency_queries.begin() +
+                                static_cast<std::ptrdiff_t>(n));
+}
+
+void base_app::note_input(tue::wsi::event_time t) noexcept {
+    m_input_pending = std::max(m_input_pending, t);
+}
+
+void base_app::report_window(double t) {
+    const auto step = stat.step.roll_window();
+    const auto draw = stat.draw.roll_window();
+    const auto gpu = stat.gpu.roll_window();
+    const auto input_swap = stat.input_swap.roll_window();
+    const auto input_gpu = stat.input_gpu.roll_window();
+
+    print("step", step);
+    print("draw", draw);
+    print("gpu ", gpu);
+    if (latency) {
+        print("input>swap", input_swap);
+        print("input>gpu ", input_gpu);
+    }
+    if (const auto n = stat.dropped_steps.load(); n > 0) {
+        std::println("steps dropped: {}", n);
+    }
+    for (const auto &r : m_gpu.results()) {
+        std::println("  {:{}}{}: {:.3f}ms", "", r.depth * 2, r.name, r.ms);
+    }
+
+    // keeps the per-thread rings from overflowing
+    if (tue::profile::enabled()) {
+        tue::profile::drain(m_trace);
+    }
+
+    if (!stats_csv.empty()) {
+        const bool fresh = !std::filesystem::exists(stats_csv);
+        std::ofstream out{stats_csv, std::ios::app};
+        if (fresh) {
+            out << "time," << tue::to_csv_header() << '\n';
+        }
+        for (auto [name, s] :
+             {std::pair{"step", step}, std::pair{"draw", draw},
+              std::pair{"gpu", gpu}, std::pair{"input_swap", input_swap},
+              std::pair{"input_gpu", input_gpu}}) {
+            if (latency || !std::string_view{name}.starts_with("input")) {
+                out << std::format("{:.3f},", t) << tue::to_csv_row(name, s)
+                    << '\n';
+            }
+        }
+    }
+}
+
+void base_app::print_totals(std::size_t drawn) const {
+    if (drawn < frames) {
+        std::println("stopped after {} of {} frames", drawn, frames);
+    }
+    std::println("total over {} frames:", drawn);
+    print("step", stat.step.total.summary());
+    print("draw", stat.draw.total.summary());
+    print("gpu ", stat.gpu.total.summary());
+    if (latency) {
+        print("input>swap", stat.input_swap.total.summary());
+        print("input>gpu ", stat.input_gpu.total.summary());
+    }
+}
+
+void base_app::export_totals() const {
+    if (stats_json.empty()) {
+        return;
+    }
+
+    std::ofstream out{stats_json, std::ios::trunc};
+    out << "[\n  " << tue::to_json("step", stat.step.total.summary())
+        << ",\n  " << tue::to_json("draw", stat.draw.total.summary())
+        << ",\n  " << tue::to_json("gpu", stat.gpu.total.summary());
+    if (latency) {
+        out << ",\n  "
+            << tue::to_json("input_swap", stat.input_swap.total.summary())
+            << ",\n  "
+            << tue::to_json("input_gpu", stat.input_gpu.total.summary());
+    }
+    out << "\n]\n";
+    if (!out) {
+        std::println(stderr, "failed to write stats to {}",
+                     stats_json.string());
+    }
+}
+
+void base_app::export_trace() {
+    if (trace_json.empty()) {
+        return;
+    }
+
+    tue::profile::set_enabled(false);
+    tue::profile::drain(m_trace);
+
+    std::ofstream out{trace_json, std::ios::trunc};
+    tue::profile::write_chrome_trace(out, m_trace);
+    if (!out) {
+        std::println(stderr, "failed to write trace to {}",
+                     trace_json.string());
+    }
+    if (const auto n = tue::profile::dropped(); n > 0) {
+        std::println(stderr, "profiler dropped {} scopes", n);
+    }
 }
 
 void base_app::watch(tue::wsi::window &wnd) {
-    auto *wcb = wnd.make_watcher();
-    tue_assert(wcb != nullptr);
-    wcb->on_size = [this](auto &w, auto e) { resize(w, e); };
-    wcb->on_draw = [this](auto &w) { redraw(w); };
-    wcb->on_keyboard = [this](auto &w, auto e) { keyboard(w, e); };
-    wcb->on_mouse = [this](auto &w, auto e) { mouse(w, e); };
+    using namespace tue::wsi;
+    wnd.watch<resize_event>([this](auto &w, auto e) { resize(w, e); });
+    wnd.watch<redraw_event>([this](auto &w, auto) { redraw(w); });
+    wnd.watch<keyboard_event>([this](auto &w, auto e) {
+        note_input(e.time);
+        keyboard(w, e);
+    });
+    wnd.watch<mouse_event>([this](auto &w, auto e) {
+        note_input(e.time);
+        mouse(w, e);
+    });
 }
@@ -1,33 +1,65 @@
 #pragma once
 
 #include <tuesday/assert.hpp>
+#include <tuesday/profile.hpp>
+#include <tuesday/utility/histogram.hpp>
+#include <tuesday/utility/precise_sleep.hpp>
 #include <tuesday/wsi.hpp>
 
 #include "helpers.hpp"
 
-struct frame_stat_data {
-    std::size_t num_frames{0};
-    delta_time frame_total{0};
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <vector>
 
-    constexpr void add_frame(delta_time dt) noexcept {
-        frame_total += dt;
-        num_frames += 1;
+/// Frame times in nanoseconds: the current reporting window and the whole
+/// run since the last reset. `add_frame` may be called from any thread.
+struct frame_stat_data {
+    tue::histogram window;
+    tue::histogram total;
+
+    void add_frame(delta_time dt) noexcept {
+        const auto ns = static_cast<std::uint64_t>(
+            std::max(dt.count(), 0.F) * 1e9F);
+        window.record(ns);
+        total.record(ns);
     }
 
-    constexpr auto frame_avg() const noexcept {
-        return delta_time{num_frames > 0 ? frame_total.count() / num_frames
-                                         : 0.};
+    /// Summary of the window, which then starts over.
+    tue::histogram_summary roll_window() noexcept {
+        const auto s = window.summary();
+        window.reset();
+        return s;
     }
 
-    constexpr auto fps() const noexcept { return 1. / frame_avg().count(); }
+    void reset() noexcept {
+        window.reset();
+        total.reset();
+    }
 };
 
 struct stat_data {
     frame_stat_data step;
     frame_stat_data draw;
-
-    constexpr auto step_fps() const noexcept { return step.fps(); }
-    constexpr auto draw_fps() const noexcept { return draw.fps(); }
+    frame_stat_data gpu; // GPU time of drawn frames, lags a few frames
+    // with `latency`: from the newest input a frame reflects to its swap,
+    // and to the GPU having finished it (a timestamp read back later)
+    frame_stat_data input_swap;
+    frame_stat_data input_gpu;
+    std::atomic<std::uint64_t> dropped_steps{0}; // to catch up with time
+
+    void reset() noexcept {
+        step.reset();
+        draw.reset();
+        gpu.reset();
+        input_swap.reset();
+        input_gpu.reset();
+        dropped_steps = 0;
+    }
 };
 
 class base_app {
@@ -36,14 +68,70 @@ class base_app {
 
     tue::wsi::window_attrs wnd_attrs{};
 
+    /// `step` runs with a fixed dt of `step_rate`, as many times as real
+    /// time requires, but at most `max_catchup_steps` per loop iteration;
+    /// the rest of a longer stall is dropped (the simulation slows down
+    /// rather than spiraling). `draw` runs at most every `draw_rate`.
     delta_time step_rate{1. / 200};
     delta_time draw_rate{1. / 60};
+    int max_catchup_steps{8};
+
+    /// Runs `step` on its own thread, concurrently with `draw`. The two
+    /// then share state only through what `publish` hands over (see
+    /// tue::triple_buffer); `reset` also runs on the simulation thread.
+    bool threaded{false};
+
+    /// Draws only when needed: after input events or `request_redraw`,
+    /// and at most every `draw_rate`. In between, the loop sleeps in
+    /// window_system::wait_events_until instead of polling, so an idle
+    /// window costs no CPU. The simulation doesn't step in this mode
+    /// (resets still apply); ignores `threaded`.
+    bool on_demand{false};
+
+    /// Starts each frame just in time for the next vblank, as predicted
+    /// by tue::wsi::frame_pacer from the CPU and GPU time of recent frames,
+    /// instead of every `draw_rate`: events are polled as the frame starts,
+    /// so input is sampled later and shows sooner. Needs vsync (a
+    /// `wnd_attrs.swap` interval other than 0): without it, `run` ignores
+    /// this option.
+    bool pace{false};
+
+    /// Measures input latency: each frame drawn after input events is
+    /// tagged with the newest event time, and timed again at its swap and
+    /// when the GPU got past the swap, from a `GL_TIMESTAMP` query read
+    /// back at a later frame and mapped to CPU time (tue::gfx::gpu_clock).
+    /// When the frame is lit on screen is not visible to GL, so both are
+    /// lower bounds of input-to-photon latency. Needs timer queries for
+    /// the GPU figure.
+    bool latency{false};
+
+    /// Renders offscreen, without a display (see tue::wsi::connect_options).
+    bool headless{false};
+
+    /// Benchmark mode: draws exactly `frames` frames as fast as possible,
+    /// stepping the simulation by `draw_rate` per frame regardless of real
+    /// time (so runs are reproducible), then prints the totals over the
+    /// frames drawn (fewer if the window closes). Turns vsync off (swap
+    /// interval 0); ignores `threaded`, `on_demand` and `pace`.
+    std::size_t frames{0};
 
     stat_data stat{};
 
+    /// Optional exports: one CSV row per stream and reporting window, and
+    /// the whole-run summaries as JSON when `run` returns.
+    std::filesystem::path stats_csv{};
+    std::filesystem::path stats_json{};
+
+    /// Optional Chrome trace (chrome://tracing, ui.perfetto.dev) of the
+    /// profiled CPU scopes; CPU profiling is enabled only when set.
+    std::filesystem::path trace_json{};
+
     virtual bool done() const;
     virtual void reset() {}
     virtual void step([[maybe_unused]] delta_time dt) {}
+    /// Called after `reset` and after each batch of steps, on the thread
+    /// running them: hands the state `draw` needs over to it.
+    virtual void publish() {}
     virtual void draw() {}
 
     virtual void resize(tue::wsi::window &w, tue::wsi::resize_event e);
@@ -52,20 +140,88 @@ class base_app {
     virtual void mouse(tue::wsi::window &w, tue::wsi::mouse_event e);
 
   public:
+    /// Sets the options above from the command line; false (after
+    /// printing why) on an unknown argument or a malformed value.
+    bool parse_args(int argc, char *argv[]);
+
     void run();
 
+    /// Feeds a synthetic event to the window (see window_system::inject).
+    void inject(tue::wsi::any_event e) { m_wsi.inject(m_wnd, e); }
+
+    tue::gfx::gpu_profiler &gpu() noexcept { return m_gpu; }
+
+    /// Uploads on a worker context when the platform provides one, inline
+    /// otherwise. Both are created by the first call, which must come from
+    /// the render thread while `run` is drawing (e.g. in `draw`); they are
+    /// gone when `run` returns.
+    tue::gfx::upload_queue &uploads();
+
+    /// How far real time is past the last step, in steps [0, 1): draw
+    /// state interpolated between the last two steps by this factor.
+    /// Always 1 when `threaded` (the latest snapshot is drawn as is).
+    float alpha() const noexcept { return m_alpha; }
+
+    /// Resets at the next step, on the thread running the steps.
+    void request_reset() noexcept { m_reset_requested = true; }
+
+    /// Draws a frame soon in `on_demand` mode. Callable from any thread.
+    void request_redraw() noexcept {
+        m_redraw_requested = true;
+        m_wsi.wake();
+    }
+
   private:
+    using duration = clock_type::duration;
+
     void do_reset();
-    bool do_step();
-    bool do_draw();
+    void reset_if_requested();
+    duration do_steps(time_point t);
+    void do_step();
+    void do_draw();
+    void do_swap();
+    void check_latency_queries();
+    void note_input(tue::wsi::event_time t) noexcept;
 
     void watch(tue::wsi::window &wnd);
+    void report_window(double t);
+    void print_totals(std::size_t drawn) const;
+    void export_totals() const;
+    void export_trace();
 
   private:
     tue::wsi::window_system m_wsi;
     tue::wsi::window m_wnd;
+    tue::gfx::gpu_profiler m_gpu; // after m_wnd: needs the context to clean up
+    tue::wsi::worker_context m_worker;
+    std::optional<tue::gfx::upload_queue> m_uploads; // uses m_worker
 
     time_point m_t_init;
-    time_point m_t_step;
     time_point m_t_draw;
+    time_point m_t_next_draw;
+    tue::wsi::frame_pacer m_pacer;
+
+    // touched by the thread running the steps only
+    duration m_step_period{};
+    duration m_acc{};
+    time_point m_t_steps;
+
+    std::atomic<bool> m_reset_requested{false};
+    std::atomic<bool> m_redraw_requested{true};
+    float m_alpha{1.F};
+
+    std::vector<tue::profile::event> m_trace;
+
+    // newest input dispatched since the last draw, and the one the latest
+    // drawn frame reflects (zero: none)
+    tue::wsi::event_time m_input_pending{};
+    tue::wsi::event_time m_input_drawn{};
+
+    struct latency_query {
+        GLuint query{0}; // GL_TIMESTAMP after the frame's swap
+        tue::wsi::event_time input;
+    };
+    std::vector<latency_query> m_latency_queries; // oldest first
+    std::vector<GLuint> m_free_queries;
+    tue::gfx::gpu_clock m_gpu_clock;
 };
@@ -10,5 +10,7 @@ class base_scene {
 
     virtual void reset() {}
     virtual void update([[maybe_unused]] delta_time dt) {}
+    /// Snapshots what `render` needs; see base_app::publish.
+    virtual void publish() {}
     virtual void render([[maybe_unused]] render_context &ctx) {}
 };
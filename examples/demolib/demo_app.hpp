@@ -11,15 +11,8 @@ class demo_app : public base_app {
         GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT;
     static constexpr tue::wsi::window_size window_size{800, 600};
 
-    demo_app() { wnd_attrs = {.size = window_size}; }
-
-    void set_scene(base_scene &scene) { m_scene = &scene; }
-
-  private:
-    bool done() const noexcept override { return m_scene == nullptr; }
-
-    void reset() override {
-        m_scene->reset();
+    demo_app() {
+        wnd_attrs = {.size = window_size};
 
         m_camera.pos = glm::vec3{0, 3, -10};
         m_camera.at = glm::vec3{0, 0, 1};
@@ -27,23 +20,46 @@ class demo_app : public base_app {
         m_camera.fov = 60.;
         m_camera.near = 0.1;
         m_camera.far = 1000;
+
+        m_context.uploads = [this]() -> tue::gfx::upload_queue & {
+            return uploads();
+        };
     }
 
+    void set_scene(base_scene &scene) { m_scene = &scene; }
+
+  private:
+    bool done() const noexcept override { return m_scene == nullptr; }
+
+    // reset, step and publish may run on the simulation thread: they must
+    // not touch the camera or the render context
+    void reset() override { m_scene->reset(); }
     void step(delta_time dt) override { m_scene->update(dt); }
+    void publish() override { m_scene->publish(); }
 
     void draw() override {
-        glClearColor(bg[0], bg[1], bg[2], bg[3]);
-        glClear(clear_bits);
-        m_scene->render(m_context);
+        m_context.state.begin_frame();
+        {
+            tue::gfx::gpu_profiler::scope s{gpu(), "demo.demo_app.clear"};
+            glClearColor(bg[0], bg[1], bg[2], bg[3]);
+            glClear(clear_bits);
+        }
+        {
+            tue::gfx::gpu_profiler::scope s{gpu(), "demo.demo_app.scene"};
+            m_context.alpha = alpha();
+            m_scene->render(m_context);
+            m_context.flush();
+        }
     }
 
     void resize(tue::wsi::window & /*w*/, tue::wsi::resize_event e) override {
         m_context.set_viewport(e.size.width, e.size.width);
 
         float ar = m_context.width / m_context.height;
-        m_context.mat_p = glm::perspective(glm::radians(m_camera.fov), ar,
-                                           m_camera.near, m_camera.far);
-        m_context.mat_v = glm::lookAt(m_camera.pos, m_camera.at, m_camera.up);
+        m_context.set_camera(
+            glm::perspective(glm::radians(m_camera.fov), ar, m_camera.near,
+                             m_camera.far),
+            glm::lookAt(m_camera.pos, m_camera.at, m_camera.up));
     }
 
   private:
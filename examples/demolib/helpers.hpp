@@ -10,24 +10,28 @@
 #include <glm/vec3.hpp>
 
 #include <chrono>
+#include <cstdint>
+#include <string_view>
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-using clock_type = std::chrono::high_resolution_clock;
+using clock_type = std::chrono::steady_clock;
 using time_point = clock_type::time_point;
 using delta_time = std::chrono::duration<float>;
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-inline const char *vert_source = R"(
+inline constexpr std::string_view vert_source = R"(
     #version 450
 
     layout (location = 0) in vec3 vPos;
     layout (location = 1) in vec3 vColor;
     layout (location = 2) in float vRadius;
 
-    uniform mat4 MatP;
-    uniform mat4 MatV;
+    layout (std140, binding = 0) uniform Camera {
+        mat4 MatP;
+        mat4 MatV;
+    };
     uniform mat4 MatM;
 
     layout (location = 0) out vec3 fPos;
@@ -46,15 +50,17 @@ inline const char *vert_source = R"(
     }
 )";
 
-inline const char *vert_source_inst = R"(
+inline constexpr std::string_view vert_source_inst = R"(
     #version 450
 
     layout (location = 0) in vec3 vPos;
     layout (location = 1) in vec3 vOff;
     layout (location = 2) in vec3 vColor;
 
-    uniform mat4 MatP;
-    uniform mat4 MatV;
+    layout (std140, binding = 0) uniform Camera {
+        mat4 MatP;
+        mat4 MatV;
+    };
     uniform mat4 MatM;
 
     layout (location = 0) out vec3 fPos;
@@ -71,7 +77,7 @@ inline const char *vert_source_inst = R"(
     }
 )";
 
-inline const char *frag_source = R"(
+inline constexpr std::string_view frag_source = R"(
     #version 450
 
     layout (location = 0) in vec3 fPos;
@@ -86,48 +92,6 @@ inline const char *frag_source = R"(
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <> struct tue::gfx::attrib_format_fn<glm::u8vec3> {
-    constexpr auto operator()() const noexcept {
-        return attrib_format{
-            .size = 3,
-            .type = GL_UNSIGNED_BYTE,
-            .normalized = GL_TRUE,
-        };
-    }
-};
-
-template <> struct tue::gfx::attrib_format_fn<glm::vec3> {
-    constexpr auto operator()() const noexcept {
-        return attrib_format{
-            .size = 3,
-            .type = GL_FLOAT,
-            .normalized = GL_FALSE,
-        };
-    }
-};
-
-template <> struct tue::gfx::vertex_attrib_format_fn<glm::u8vec3> {
-    constexpr auto operator()() const noexcept {
-        return tue::gfx::vertex_attrib_format{
-            .index = 0,
-            .offset = 0,
-            .attr = tue::gfx::attrib_format_for<glm::u8vec3>,
-        };
-    }
-};
-
-template <> struct tue::gfx::vertex_attrib_format_fn<glm::vec3> {
-    constexpr auto operator()() const noexcept {
-        return tue::gfx::vertex_attrib_format{
-            .index = 0,
-            .offset = 0,
-            .attr = tue::gfx::attrib_format_for<glm::vec3>,
-        };
-    }
-};
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-
 constexpr auto cube_vertices(float r) noexcept {
     return std::array{
         // front
@@ -144,7 +108,7 @@ constexpr auto cube_vertices(float r) noexcept {
 }
 
 constexpr auto cube_indices() noexcept {
-    return std::array{
+    return std::array<std::uint32_t, 36>{
         0, 1, 2, 2, 3, 0, // front
         4, 5, 6, 6, 7, 4, // back
         5, 0, 3, 3, 6, 5, // left
@@ -1,7 +1,12 @@
 #pragma once
 
+#include <tuesday/utility/delegate.hpp>
+
 #include "helpers.hpp"
 
+#include <algorithm>
+#include <vector>
+
 struct camera {
     glm::vec3 pos{0, 0, -1};
     glm::vec3 at{0};
@@ -12,24 +17,80 @@ struct camera {
     float far{1000};
 };
 
+/// Per-frame data shared by all programs (`Camera` block in the shaders).
+struct camera_block {
+    glm::mat4 mat_p{1};
+    glm::mat4 mat_v{1};
+};
+
+template <> struct tue::gfx::std140_layout_fn<camera_block> {
+    constexpr auto operator()() const noexcept {
+        return std::array{
+            TUE_STD140_MEMBER(camera_block, mat_p),
+            TUE_STD140_MEMBER(camera_block, mat_v),
+        };
+    }
+};
+
 struct render_context {
+    static constexpr GLuint camera_binding = 0;
+    static constexpr auto key_mat_m = tue::gfx::make_uniform_key("MatM");
+
+    struct program_uniforms {
+        GLuint id{0};
+        GLint mat_m{-1};
+    };
+
     float width{0};
     float height{0};
     float aspect_ratio{0};
 
-    glm::mat4 mat_p{1};
-    glm::mat4 mat_v{1};
+    /// Blend factor from the previous to the current simulation step.
+    float alpha{1};
+
+    /// The app's upload queue (see base_app::uploads), if it has one.
+    tue::delegate<tue::gfx::upload_queue &()> uploads;
+
     glm::mat4 mat_m{1};
 
-    tue::gfx::shader_program m_shader;
-    tue::gfx::vertex_array m_vao;
+    tue::gfx::state_cache state;
+    tue::gfx::draw_queue queue;
+    std::vector<program_uniforms> m_uniforms;
+    std::vector<glm::mat4> m_models; // mat_m of each submit, see `submit`
+
+    camera_block m_camera{};
+    tue::gfx::uniform_block<camera_block> m_camera_ubo;
+    bool m_camera_dirty{true};
+
+    const camera_block &camera_data() const noexcept { return m_camera; }
+
+    void set_camera(const glm::mat4 &mat_p, const glm::mat4 &mat_v) {
+        m_camera = camera_block{.mat_p = mat_p, .mat_v = mat_v};
+        m_camera_dirty = true;
+    }
+
+    /// Uploads camera matrices at most once per change, for all programs.
+    void sync_camera() {
+        if (!m_camera_dirty) {
+            return;
+        }
+        if (!m_camera_ubo) {
+            m_camera_ubo = tue::gfx::create_uniform_block(m_camera);
+        }
+        else {
+            update_uniform_block(m_camera_ubo, m_camera);
+        }
+        state.bind_buffer_base(GL_UNIFORM_BUFFER, camera_binding,
+                               m_camera_ubo.id);
+        m_camera_dirty = false;
+    }
 
     void set_viewport(int width_, int height_) {
         if (tue_assert(width_ > 0 && height_ > 0)) {
             width = width_;
             height = height_;
             aspect_ratio = width / height;
-            glViewport(0, 0, width_, height_);
+            state.viewport(0, 0, width_, height_);
         }
         else {
             width = height = aspect_ratio = 0;
@@ -37,27 +98,76 @@ struct render_context {
     }
 
     void use(tue::gfx::shader_program shader) {
-        if (m_shader.id != shader.id) {
-            glUseProgram(shader.id);
-            m_shader = shader;
-        }
+        sync_camera();
+
+        state.use_program(shader);
+        bind_uniform(shader, uniforms_of(shader).mat_m, mat_m);
+    }
 
-        glUniformMatrix4fv(find_uniform(shader, "MatP"), 1, GL_FALSE,
-                           glm::value_ptr(mat_p));
-        glUniformMatrix4fv(find_uniform(shader, "MatV"), 1, GL_FALSE,
-                           glm::value_ptr(mat_v));
-        glUniformMatrix4fv(find_uniform(shader, "MatM"), 1, GL_FALSE,
-                           glm::value_ptr(mat_m));
+    /// Drops cached uniform locations (call before deleting the program).
+    void forget(tue::gfx::shader_program shader) {
+        std::erase_if(m_uniforms, [id = shader.id](const auto &u) {
+            return u.id == id;
+        });
+        state.forget_program(shader.id);
     }
 
-    void use(tue::gfx::vertex_array vao) {
-        if (vao.id != m_vao.id) {
-            glBindVertexArray(vao.id);
-            m_vao = vao;
+    const program_uniforms &uniforms_of(tue::gfx::shader_program shader) {
+        auto it = std::ranges::find(m_uniforms, shader.id,
+                                    &program_uniforms::id);
+        if (it != m_uniforms.end()) {
+            return *it;
         }
+
+        // reflect once per program, the draw path only sees locations
+        const auto table = tue::gfx::reflect_uniforms(shader);
+        return m_uniforms.emplace_back(program_uniforms{
+            .id = shader.id,
+            .mat_m = table.location(key_mat_m),
+        });
     }
 
+    void use(tue::gfx::vertex_array vao) { state.bind_vertex_array(vao); }
+
     void draw(tue::gfx::vertex_buffer vbo, GLenum mode) {
         glDrawArrays(mode, 0, vbo.count);
     }
+
+    /// Defers a draw; the key groups commands by program and VAO.
+    ///
+    /// The current `mat_m` goes with the command (its `user` field indexes
+    /// the copy), so objects may set their own matrix before each submit.
+    void submit(tue::gfx::draw_command cmd, std::uint8_t pass = 0) {
+        cmd.key = tue::gfx::make_sort_key({
+            .pass = pass,
+            .program = static_cast<std::uint16_t>(cmd.program.id),
+            .vao = static_cast<std::uint16_t>(cmd.vao.id),
+        });
+        if (m_models.empty() || m_models.back() != mat_m) {
+            m_models.push_back(mat_m);
+        }
+        cmd.user = static_cast<std::uint32_t>(m_models.size() - 1);
+        queue.push(cmd);
+    }
+
+    /// Executes all submitted commands in state-minimizing order.
+    void flush() {
+        tue_profile_scope("demo.render_context.flush");
+        sync_camera();
+
+        queue.sort();
+        GLuint last_program = 0;
+        std::uint32_t last_model = 0;
+        queue.execute(state, [&](const tue::gfx::draw_command &cmd) {
+            // a uniform belongs to its program: rebind after each switch
+            if (cmd.program.id != last_program || cmd.user != last_model) {
+                last_program = cmd.program.id;
+                last_model = cmd.user;
+                bind_uniform(cmd.program, uniforms_of(cmd.program).mat_m,
+                             m_models[cmd.user]);
+            }
+        });
+        queue.clear();
+        m_models.clear();
+    }
 };
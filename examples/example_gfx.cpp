@@ -74,7 +74,25 @@ struct particle_system {
         delete_shader(shader);
     }
 
-    void init([[maybe_unused]] render_context &ctx) {
+    /// Drops the GL objects of a previous `init`, cached state included.
+    void release(render_context &ctx) {
+        for (auto &a : data.attrs) {
+            ctx.state.forget_buffer(a.vbo.id);
+            delete_vertex_buffer(a.vbo);
+        }
+        ctx.state.forget_buffer(vbo_one.id);
+        delete_vertex_buffer(vbo_one);
+        ctx.state.forget_vertex_array(vao.id);
+        delete_vertex_array(vao);
+        if (shader) {
+            ctx.forget(shader);
+            delete_shader(shader);
+        }
+    }
+
+    void init(render_context &ctx) {
+        // also a reload (space key): the previous objects go first
+        release(ctx);
         data.reset(part_count);
 
         for (size_t i{0}; i < part_count; ++i) {
@@ -107,15 +125,18 @@ struct particle_system {
     }
 
     void draw(render_context &ctx) {
-        ctx.use(shader);
-        ctx.use(vao);
-
         for (auto &a : data.attrs) {
             glNamedBufferData(a.vbo.id, a.size, nullptr, GL_STREAM_DRAW);
             glNamedBufferSubData(a.vbo.id, 0, a.size, a.data);
         }
 
-        glDrawArraysInstanced(GL_TRIANGLES, 0, part_mesh.size(), part_count);
+        ctx.submit({
+            .program = shader,
+            .vao = vao,
+            .mode = GL_TRIANGLES,
+            .count = static_cast<GLsizei>(part_mesh.size()),
+            .instances = static_cast<GLsizei>(part_count),
+        });
     }
 
     void sync(sync_context &ctx) {
@@ -168,15 +189,14 @@ int main() {
 
     auto wsi = tue::wsi::connect();
     auto wnd = wsi.make_window();
-    auto *wcb = wnd.make_watcher();
 
     // setup callbacks
 
-    wcb->on_size = [&scn](auto & /*wnd*/, auto e) {
+    wnd.watch<tue::wsi::resize_event>([&scn](auto & /*wnd*/, auto e) {
         scn.resize(e.size.width, e.size.height);
-    };
+    });
 
-    wcb->on_keyboard = [&scn](auto &w, auto e) {
+    wnd.watch<tue::wsi::keyboard_event>([&scn](auto &w, auto e) {
         using tue::wsi::key_code;
         if (e.pressed(key_code::escape)) {
             w.close();
@@ -188,20 +208,20 @@ int main() {
             scn.init();
             scn.resize(w.get_attrs().size.width, w.get_attrs().size.height);
         }
-    };
+    });
 
-    wcb->on_draw = [&scn](auto & /*wnd*/) {
+    wnd.watch<tue::wsi::redraw_event>([&scn](auto & /*wnd*/, auto) {
         std::println("draw requested");
         scn.draw();
-    };
+    });
 
-    wcb->on_mouse = [](auto & /*wnd*/, auto e) {
+    wnd.watch<tue::wsi::mouse_event>([](auto & /*wnd*/, auto e) {
         using tue::wsi::key_code;
         using tue::wsi::key_mods;
         if (e.holds(key_mods::alt) && e.pressed(key_code::mouse_left)) {
             std::println("{}x{}", e.pos.x, e.pos.y);
         }
-    };
+    });
 
     auto attrs = wnd.get_attrs()
                      .with(tue::wsi::window_size{800, 600})
@@ -264,7 +284,9 @@ int main() {
 
         stat_rate -= dt;
         if (stat_rate.count() <= 0) {
-            std::println("fps={}; ips={}", num_draws, num_sims);
+            const auto gs = scn.context().state.frame_stats();
+            std::println("fps={}; ips={}; gl state: issued={}, filtered={}",
+                         num_draws, num_sims, gs.issued(), gs.filtered);
             stat_rate = std::chrono::seconds{1};
             num_draws = 0;
             num_sims = 0;
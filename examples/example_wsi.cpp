@@ -10,16 +10,14 @@ int main() {
     auto wsi = tue::wsi::connect();
     // ask for a new window
     auto wnd = wsi.make_window();
-    // ask for a event watcher
-    auto *wcb = wnd.make_watcher();
 
     // setup callbacks
 
-    wcb->on_size = [](auto & /*wnd*/, auto e) {
+    wnd.watch<tue::wsi::resize_event>([](auto & /*wnd*/, auto e) {
         glViewport(0, 0, e.size.width, e.size.height);
-    };
+    });
 
-    wcb->on_keyboard = [](auto &wnd, auto e) {
+    wnd.watch<tue::wsi::keyboard_event>([](auto &wnd, auto e) {
         using tue::wsi::key_code;
         if (e.pressed(key_code::escape)) {
             wnd.close();
@@ -27,20 +25,20 @@ int main() {
         else if (e.pressed(key_code::F)) {
             wnd.toggle_fullscreen();
         }
-    };
+    });
 
-    wcb->on_draw = [](auto & /*wnd*/) {
+    wnd.watch<tue::wsi::redraw_event>([](auto & /*wnd*/, auto) {
         glClearColor(0.1, 0.1, 0.1, 1);
         glClear(GL_COLOR_BUFFER_BIT);
-    };
+    });
 
-    wcb->on_mouse = [](auto & /*wnd*/, auto e) {
+    wnd.watch<tue::wsi::mouse_event>([](auto & /*wnd*/, auto e) {
         using tue::wsi::key_code;
         using tue::wsi::key_mods;
         if (e.holds(key_mods::alt) && e.pressed(key_code::mouse_left)) {
             std::println("{}x{}", e.pos.x, e.pos.y);
         }
-    };
+    });
 
     auto attrs = wnd.get_attrs()
                      .with(tue::wsi::window_size{800, 600})
@@ -155,7 +155,8 @@ class scene_root {
     }
 
     void init() {
-        m_draw_ctx.mat_p = m_draw_ctx.mat_v = m_draw_ctx.mat_m = glm::mat4{1};
+        m_draw_ctx.set_camera(glm::mat4{1}, glm::mat4{1});
+        m_draw_ctx.mat_m = glm::mat4{1};
         m_sync_ctx.dt = delta_time::zero();
 
         for (auto &o : m_objs) {
@@ -165,9 +166,11 @@ class scene_root {
     }
 
     void draw() {
+        m_draw_ctx.state.begin_frame();
         for (auto &o : m_objs) {
             o.draw(m_draw_ctx);
         }
+        m_draw_ctx.flush();
     }
 
     void sync(delta_time dt) {
@@ -178,6 +181,8 @@ class scene_root {
     }
 
   public:
+    const render_context &context() const noexcept { return m_draw_ctx; }
+
     template <typename T> void emplace_back(T &&obj) {
         m_objs.emplace_back(std::forward<T>(obj));
     }
@@ -230,8 +235,8 @@ constexpr void tue_draw(render_context &ctx, camera &o) noexcept {
     }
 
     float ar = ctx.width / ctx.height;
-    ctx.mat_p = glm::perspective(glm::radians(o.fov), ar, o.near, o.far);
-    ctx.mat_v = glm::lookAt(o.pos, o.at, o.up);
+    ctx.set_camera(glm::perspective(glm::radians(o.fov), ar, o.near, o.far),
+                   glm::lookAt(o.pos, o.at, o.up));
 }
 
 constexpr void tue_init([[maybe_unused]] sync_context &ctx,
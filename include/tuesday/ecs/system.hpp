@@ -3,10 +3,12 @@
 
 #include <tuesday/mp/tseq.hpp>
 #include <tuesday/mp/tseq_ops.hpp>
+#include <tuesday/profile.hpp>
 
 #include <map>
 #include <memory>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace tue::ecs {
@@ -54,7 +56,12 @@ template <class E> class system_base {
 ///
 template <class Derived, class E> class basic_system : public system_base<E> {
   public:
-    //
+    /// Calls `Derived::update(args...)` in a profiler scope named by
+    /// `Derived::profile_name`, a string literal ("module.system.update").
+    template <typename... Args> void run(Args &&...args) {
+        tue_profile_scope(Derived::profile_name);
+        static_cast<Derived &>(*this).update(std::forward<Args>(args)...);
+    }
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
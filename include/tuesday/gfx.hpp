@@ -2,8 +2,20 @@
 #define _TUE_GFX_HPP_INCLUDED_
 
 #include <tuesday/gfx/draw.hpp>
+#include <tuesday/gfx/draw_queue.hpp>
+#include <tuesday/gfx/gpu_fence.hpp>
+#include <tuesday/gfx/gpu_profiler.hpp>
+#include <tuesday/gfx/mesh_batch.hpp>
 #include <tuesday/gfx/shader.hpp>
+#include <tuesday/gfx/shader_cache.hpp>
+#include <tuesday/gfx/shader_compiler.hpp>
+#include <tuesday/gfx/state_cache.hpp>
+#include <tuesday/gfx/uniform_block.hpp>
+#include <tuesday/gfx/upload_queue.hpp>
 #include <tuesday/gfx/vertex_array.hpp>
+#include <tuesday/gfx/vertex_cache.hpp>
+#include <tuesday/gfx/vertex_layout.hpp>
+#include <tuesday/gfx/vertex_pack.hpp>
 
 namespace tue::gfx {}
 
@@ -0,0 +1,171 @@
+#ifndef _TUE_GFX_DRAW_QUEUE_HPP_INCLUDED_
+#define _TUE_GFX_DRAW_QUEUE_HPP_INCLUDED_
+
+#include <tuesday/gfx/gl.hpp>
+#include <tuesday/gfx/shader.hpp>
+#include <tuesday/gfx/state_cache.hpp>
+#include <tuesday/gfx/vertex_array.hpp>
+#include <tuesday/profile.hpp>
+#include <tuesday/utility/radix_sort.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace tue::gfx {
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+/// Fields of a draw sort key, most significant first.
+///
+/// Program, VAO and material are truncated to 12 bits: the key only defines
+/// the order (and thus how well state changes group), commands keep the full
+/// names. Depth is a 24-bit quantized value, see `depth_key`.
+struct sort_key_fields {
+    std::uint8_t pass{0};      // 4 bits
+    std::uint16_t program{0};  // 12 bits
+    std::uint16_t vao{0};      // 12 bits
+    std::uint16_t material{0}; // 12 bits
+    std::uint32_t depth{0};    // 24 bits
+};
+
+constexpr std::uint64_t make_sort_key(sort_key_fields f) noexcept {
+    return (std::uint64_t{f.pass & 0xFU} << 60) |
+           (std::uint64_t{f.program & 0xFFFU} << 48) |
+           (std::uint64_t{f.vao & 0xFFFU} << 36) |
+           (std::uint64_t{f.material & 0xFFFU} << 24) |
+           (std::uint64_t{f.depth & 0xFFFFFFU});
+}
+
+constexpr sort_key_fields split_sort_key(std::uint64_t k) noexcept {
+    return sort_key_fields{
+        .pass = static_cast<std::uint8_t>((k >> 60) & 0xFU),
+        .program = static_cast<std::uint16_t>((k >> 48) & 0xFFFU),
+        .vao = static_cast<std::uint16_t>((k >> 36) & 0xFFFU),
+        .material = static_cast<std::uint16_t>((k >> 24) & 0xFFFU),
+        .depth = static_cast<std::uint32_t>(k & 0xFFFFFFU),
+    };
+}
+
+/// Quantizes a normalized depth [0, 1]; pass `1 - d` for back-to-front.
+constexpr std::uint32_t depth_key(float d) noexcept {
+    d = d < 0.F ? 0.F : (d > 1.F ? 1.F : d);
+    return static_cast<std::uint32_t>(d * float(0xFFFFFF));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+/// A draw of `count` vertices starting at `first`; with an `index_type` set
+/// the VAO's element buffer is used and `first` counts indices instead.
+struct draw_command {
+    std::uint64_t key{0};
+    shader_program program{};
+    vertex_array vao{};
+    GLenum mode{GL_TRIANGLES};
+    GLint first{0};
+    GLsizei count{0};
+    GLsizei instances{1};
+    GLuint base_instance{0};
+    GLenum index_type{GL_NONE};
+    GLint base_vertex{0};
+    std::uint32_t user{0}; // free for the submitter, e.g. an object index
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+/// Deferred draw commands, executed in sort-key order.
+///
+/// Command generation is independent of GL, so worker threads may fill
+/// their own queues and the render thread `append`s them before `sort`.
+class draw_queue {
+  public:
+    bool empty() const noexcept { return m_cmds.empty(); }
+    std::size_t size() const noexcept { return m_cmds.size(); }
+
+    const draw_command &operator[](std::size_t i) const noexcept {
+        return m_cmds[m_order[i].index];
+    }
+
+  public:
+    void reserve(std::size_t n) {
+        m_cmds.reserve(n);
+        m_order.reserve(n);
+    }
+
+    void clear() noexcept {
+        m_cmds.clear();
+        m_order.clear();
+    }
+
+    void push(const draw_command &cmd) {
+        m_order.push_back(
+            entry{cmd.key, static_cast<std::uint32_t>(m_cmds.size())});
+        m_cmds.push_back(cmd);
+    }
+
+    void append(const draw_queue &other) {
+        reserve(size() + other.size());
+        for (const auto &cmd : other.m_cmds) {
+            push(cmd);
+        }
+    }
+
+    /// Orders commands by key (stable for equal keys).
+    void sort() {
+        m_scratch.resize(m_order.size());
+        radix_sort(std::span{m_order}, std::span{m_scratch}, &entry::key);
+    }
+
+    /// Issues all commands in the current order. `before_draw(cmd)` runs
+    /// after the command's program and VAO are bound.
+    template <class Fn> void execute(state_cache &state, Fn &&before_draw) {
+        tue_profile_scope("gfx.draw_queue.execute");
+        for (const auto &e : m_order) {
+            const auto &cmd = m_cmds[e.index];
+            state.use_program(cmd.program);
+            state.bind_vertex_array(cmd.vao);
+            before_draw(cmd);
+            issue(cmd);
+        }
+    }
+
+    void execute(state_cache &state) {
+        execute(state, [](const draw_command &) {});
+    }
+
+  private:
+    static void issue(const draw_command &cmd) noexcept {
+        if (cmd.index_type != GL_NONE) {
+            const auto offset =
+                static_cast<std::uintptr_t>(cmd.first) *
+                static_cast<std::uintptr_t>(index_size(cmd.index_type));
+            glDrawElementsInstancedBaseVertexBaseInstance(
+                cmd.mode, cmd.count, cmd.index_type,
+                reinterpret_cast<const void *>(offset), cmd.instances,
+                cmd.base_vertex, cmd.base_instance);
+        }
+        else if (cmd.instances == 1 && cmd.base_instance == 0) {
+            glDrawArrays(cmd.mode, cmd.first, cmd.count);
+        }
+        else {
+            glDrawArraysInstancedBaseInstance(cmd.mode, cmd.first, cmd.count,
+                                              cmd.instances,
+                                              cmd.base_instance);
+        }
+    }
+
+  private:
+    struct entry {
+        std::uint64_t key{0};
+        std::uint32_t index{0};
+    };
+
+    std::vector<draw_command> m_cmds;
+    std::vector<entry> m_order;
+    std::vector<entry> m_scratch;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+} // namespace tue::gfx
+
+#endif
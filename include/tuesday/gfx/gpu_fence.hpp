@@ -0,0 +1,56 @@
+#ifndef _TUE_GFX_GPU_FENCE_HPP_INCLUDED_
+#define _TUE_GFX_GPU_FENCE_HPP_INCLUDED_
+
+#include <tuesday/assert.hpp>
+#include <tuesday/gfx/gl.hpp>
+
+#include <chrono>
+
+namespace tue::gfx {
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+/// A point in the GL command stream (`glFenceSync`), signaled once the GPU
+/// has executed every command submitted before it. Fences are visible to
+/// all contexts sharing objects with the one that inserted them.
+struct gpu_fence {
+    GLsync sync{nullptr};
+
+    explicit constexpr operator bool() const noexcept {
+        return sync != nullptr;
+    }
+};
+
+inline gpu_fence insert_fence() {
+    gpu_fence f{glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0)};
+    tue_assert(f.sync != nullptr);
+    return f;
+}
+
+/// Waits up to `timeout` for the fence; zero only checks it. Flushes the
+/// calling context first, so a fence it inserted is sure to signal.
+inline bool wait_fence(gpu_fence f, std::chrono::nanoseconds timeout = {}) {
+    tue_assert(f.sync != nullptr);
+    const auto ns = static_cast<GLuint64>(
+        timeout > std::chrono::nanoseconds::zero() ? timeout.count() : 0);
+    const auto r = glClientWaitSync(f.sync, GL_SYNC_FLUSH_COMMANDS_BIT, ns);
+    return r == GL_ALREADY_SIGNALED || r == GL_CONDITION_SATISFIED;
+}
+
+/// Doesn't block: same as `wait_fence(f)`.
+inline bool is_signaled(gpu_fence f) {
+    return wait_fence(f);
+}
+
+inline void delete_fence(gpu_fence &f) {
+    if (f) {
+        glDeleteSync(f.sync);
+    }
+    f = gpu_fence{};
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+} // namespace tue::gfx
+
+#endif
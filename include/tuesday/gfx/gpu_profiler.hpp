@@ -0,0 +1,167 @@
+#ifndef _TUE_GFX_GPU_PROFILER_HPP_INCLUDED_
+#define _TUE_GFX_GPU_PROFILER_HPP_INCLUDED_
+
+#include <tuesday/gfx/gl.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace tue::gfx {
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+/// Whether the result of `query` is ready; never blocks.
+inline bool query_available(GLuint query) noexcept {
+    GLint ready{GL_FALSE};
+    glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &ready);
+    return ready != GL_FALSE;
+}
+
+/// The result of a finished query: nanoseconds for timer queries.
+inline GLuint64 query_result(GLuint query) noexcept {
+    GLuint64 v{0};
+    glGetQueryObjectui64v(query, GL_QUERY_RESULT, &v);
+    return v;
+}
+
+/// Maps `GL_TIMESTAMP` values to steady_clock, from one reading of both
+/// clocks; `sync` again now and then, as the two drift apart.
+class gpu_clock {
+  public:
+    using time_point = std::chrono::steady_clock::time_point;
+
+    void sync() noexcept {
+        GLint64 gpu{0};
+        glGetInteger64v(GL_TIMESTAMP, &gpu);
+        m_cpu = std::chrono::steady_clock::now();
+        m_gpu = gpu;
+    }
+
+    time_point to_cpu(GLuint64 gpu_ns) const noexcept {
+        return m_cpu +
+               std::chrono::nanoseconds{static_cast<GLint64>(gpu_ns) - m_gpu};
+    }
+
+  private:
+    time_point m_cpu{};
+    GLint64 m_gpu{0};
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+///
+struct gpu_scope_result {
+    std::string_view name{};
+    std::uint32_t depth{0};
+    double start_ms{0.}; // since the beginning of the frame
+    double ms{0.};
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+/// GPU time of frames and nested named scopes, from `GL_TIMESTAMP` queries.
+///
+/// Every frame records into one of `frames_in_flight` query sets. A set is
+/// read back only once `GL_QUERY_RESULT_AVAILABLE` says the GPU is done
+/// with it, so the profiler never stalls; if a set is still busy when its
+/// turn comes again, that frame is dropped. Timestamps are used rather
+/// than `GL_TIME_ELAPSED`, since elapsed-time queries cannot be nested.
+///
+/// Queries are pooled per set and allocated by `begin_frame` and `begin`
+/// only, each reserving the query of its end: `end` and `end_frame` never
+/// allocate, so closing a scope can't throw.
+///
+/// Scope names are kept as views and must outlive the results (literals
+/// are fine). All calls must be made on the thread owning the GL context.
+class gpu_profiler {
+  public:
+    /// Closes its scope on destruction.
+    class scope {
+      public:
+        scope(gpu_profiler &p, std::string_view name) : m_p{&p} {
+            m_p->begin(name);
+        }
+        ~scope() { m_p->end(); }
+
+        scope(const scope &) = delete;
+        scope &operator=(const scope &) = delete;
+
+      private:
+        gpu_profiler *m_p;
+    };
+
+  public:
+    explicit gpu_profiler(std::size_t frames_in_flight = 4);
+    ~gpu_profiler();
+
+    gpu_profiler(const gpu_profiler &) = delete;
+    gpu_profiler &operator=(const gpu_profiler &) = delete;
+
+  public:
+    /// False if timer queries are unsupported (known after `begin_frame`).
+    bool enabled() const noexcept { return m_supported; }
+
+    /// Reads back finished frames and starts recording a new one.
+    /// Returns true if newer results became available.
+    bool begin_frame();
+    void end_frame() noexcept;
+
+    void begin(std::string_view name);
+    void end() noexcept;
+
+  public:
+    /// GPU time of the latest frame read back.
+    double frame_ms() const noexcept { return m_frame_ms; }
+
+    /// Scopes of the latest frame read back, in begin order.
+    std::span<const gpu_scope_result> results() const noexcept {
+        return m_results;
+    }
+
+    /// Frames whose queries were still busy when their set was reused.
+    std::size_t dropped() const noexcept { return m_dropped; }
+
+  private:
+    struct marker {
+        std::string_view name{};
+        std::uint32_t depth{0};
+        std::uint32_t begin{0}; // query indices in the frame set
+        std::uint32_t end{0};
+    };
+
+    struct frame_set {
+        std::vector<GLuint> queries;
+        std::size_t used{0};
+        std::vector<marker> markers; // [0] is the whole frame
+        bool pending{false};
+    };
+
+    /// Makes room for `n` more timestamps in the set.
+    void reserve(frame_set &set, std::size_t n);
+    std::uint32_t timestamp(frame_set &set) noexcept;
+    bool available(const frame_set &set) const noexcept;
+    void read_back(frame_set &set);
+
+  private:
+    std::vector<frame_set> m_sets;
+    std::size_t m_current{0};
+    std::vector<std::uint32_t> m_open; // markers of open scopes
+    bool m_recording{false};
+    bool m_checked{false};
+    bool m_supported{false};
+
+    std::vector<GLuint64> m_times;
+    std::vector<gpu_scope_result> m_results;
+    double m_frame_ms{0.};
+    std::size_t m_dropped{0};
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+} // namespace tue::gfx
+
+#endif
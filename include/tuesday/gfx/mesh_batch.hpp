@@ -0,0 +1,206 @@
+#ifndef _TUE_GFX_MESH_BATCH_HPP_INCLUDED_
+#define _TUE_GFX_MESH_BATCH_HPP_INCLUDED_
+
+#include <tuesday/assert.hpp>
+#include <tuesday/gfx/gl.hpp>
+#include <tuesday/gfx/state_cache.hpp>
+#include <tuesday/gfx/vertex_array.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace tue::gfx {
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+/// Layout mandated by `glMultiDrawArraysIndirect`.
+struct draw_arrays_indirect_command {
+    GLuint count{0};
+    GLuint instance_count{0};
+    GLuint first{0};
+    GLuint base_instance{0};
+};
+
+/// Layout mandated by `glMultiDrawElementsIndirect`.
+struct draw_elements_indirect_command {
+    GLuint count{0};
+    GLuint instance_count{0};
+    GLuint first_index{0};
+    GLint base_vertex{0};
+    GLuint base_instance{0};
+};
+
+static_assert(sizeof(draw_arrays_indirect_command) == 16);
+static_assert(sizeof(draw_elements_indirect_command) == 20);
+
+///
+struct mesh_range {
+    GLuint first_vertex{0};
+    GLuint vertex_count{0};
+    GLuint first_index{0};
+    GLuint index_count{0}; // 0 for non-indexed meshes
+
+    constexpr bool indexed() const noexcept { return index_count > 0; }
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+/// Many meshes packed into one vertex buffer and one index buffer.
+///
+/// Meshes are appended on the CPU and `upload` (re)creates both buffers.
+/// Indices are stored relative to their mesh, the offset is applied through
+/// `base_vertex` of the indirect command; so they are narrowed to 16 bits
+/// as long as no single mesh needs more.
+///
+/// Destruction deletes the buffers without telling any state_cache: use
+/// `release` while the cache that bound them is still in use.
+template <class Vertex> class mesh_batch {
+    static_assert(std::is_trivially_copyable_v<Vertex>,
+                  "Must be trivially copyable");
+
+  public:
+    mesh_batch() = default;
+    mesh_batch(const mesh_batch &) = delete;
+    mesh_batch &operator=(const mesh_batch &) = delete;
+    ~mesh_batch() {
+        delete_vertex_buffer(m_vbo);
+        delete_index_buffer(m_ibo);
+    }
+
+  public:
+    std::size_t vertex_count() const noexcept { return m_vertices.size(); }
+    std::size_t index_count() const noexcept { return m_indices.size(); }
+
+    vertex_buffer vertices() const noexcept { return m_vbo; }
+    index_buffer indices() const noexcept { return m_ibo; }
+
+  public:
+    mesh_range add(std::span<const Vertex> vertices) {
+        mesh_range m{
+            .first_vertex = static_cast<GLuint>(m_vertices.size()),
+            .vertex_count = static_cast<GLuint>(vertices.size()),
+        };
+        m_vertices.insert(m_vertices.end(), vertices.begin(), vertices.end());
+        return m;
+    }
+
+    mesh_range add(std::span<const Vertex> vertices,
+                   std::span<const GLuint> indices) {
+        auto m = add(vertices);
+        m.first_index = static_cast<GLuint>(m_indices.size());
+        m.index_count = static_cast<GLuint>(indices.size());
+        m_indices.insert(m_indices.end(), indices.begin(), indices.end());
+        m_max_mesh_vertices = std::max(m_max_mesh_vertices, vertices.size());
+        return m;
+    }
+
+    /// (Re)creates the buffers; `state` forgets the replaced ones.
+    void upload(state_cache &state, GLenum usage = GL_STATIC_DRAW) {
+        release(state);
+        if (!m_vertices.empty()) {
+            m_vbo = create_vertex_buffer(std::span{m_vertices}, usage);
+        }
+        if (!m_indices.empty()) {
+            m_ibo = create_index_buffer(std::span{m_indices},
+                                       m_max_mesh_vertices, usage);
+        }
+    }
+
+    /// Attaches the shared buffers to a VAO (attrib formats are up to you).
+    void bind(vertex_array vao, GLuint binding_index) const {
+        tue_assert(m_vbo.id != 0, "batch is not uploaded");
+        bind_buffer(vao, binding_index, m_vbo);
+        if (m_ibo) {
+            bind_index_buffer(vao, m_ibo);
+        }
+    }
+
+    void release(state_cache &state) {
+        if (m_vbo) {
+            state.forget_buffer(m_vbo.id);
+        }
+        if (m_ibo) {
+            state.forget_buffer(m_ibo.id);
+        }
+        delete_vertex_buffer(m_vbo);
+        delete_index_buffer(m_ibo);
+    }
+
+  private:
+    std::vector<Vertex> m_vertices;
+    std::vector<std::uint32_t> m_indices;
+    std::size_t m_max_mesh_vertices{0};
+    vertex_buffer m_vbo{};
+    index_buffer m_ibo{};
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+/// CPU-built indirect command list for meshes of a `mesh_batch`.
+///
+/// Each `push` becomes one indirect command; `draw` issues all of them with
+/// at most two calls (arrays and elements). Per-object data can be fetched
+/// in the shader through `gl_BaseInstance` / `gl_DrawID` or instanced
+/// attributes addressed by `base_instance`.
+class indirect_commands {
+  public:
+    indirect_commands() = default;
+    indirect_commands(const indirect_commands &) = delete;
+    indirect_commands &operator=(const indirect_commands &) = delete;
+    ~indirect_commands();
+
+  public:
+    bool empty() const noexcept { return m_arrays.empty() && m_elems.empty(); }
+
+    std::span<const draw_arrays_indirect_command> arrays() const noexcept {
+        return m_arrays;
+    }
+    std::span<const draw_elements_indirect_command> elements() const noexcept {
+        return m_elems;
+    }
+
+    /// Where the element commands start in the GL buffer, in bytes: right
+    /// after the array ones (both structs are 4-byte aligned).
+    std::size_t elements_offset() const noexcept {
+        return m_arrays.size() * sizeof(draw_arrays_indirect_command);
+    }
+
+    void clear() noexcept {
+        m_arrays.clear();
+        m_elems.clear();
+    }
+
+    void push(mesh_range m, GLuint instance_count = 1,
+              GLuint base_instance = 0);
+
+    /// Copies the commands into the GL buffer (growing it if needed).
+    void upload();
+
+    /// Draws everything uploaded; the VAO must have the batch bound, with
+    /// indices of `index_type` (see `mesh_batch::indices`).
+    void draw(state_cache &state, vertex_array vao, GLenum mode,
+              GLenum index_type = GL_UNSIGNED_INT) const;
+
+    /// Deletes the GL buffer; `state` forgets it. Destruction does the same
+    /// without a state_cache.
+    void release(state_cache &state) noexcept;
+
+  private:
+    std::vector<draw_arrays_indirect_command> m_arrays;
+    std::vector<draw_elements_indirect_command> m_elems;
+    GLuint m_buffer{0};
+    GLsizeiptr m_capacity{0};
+    GLsizei m_num_arrays{0};
+    GLsizei m_num_elems{0};
+    GLintptr m_elems_offset{0};
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+} // namespace tue::gfx
+
+#endif
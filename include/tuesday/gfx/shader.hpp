@@ -4,8 +4,20 @@
 #include <tuesday/assert.hpp>
 #include <tuesday/gfx/gl.hpp>
 
+#if defined(TUE_HAS_GLM)
+#include <glm/gtc/type_ptr.hpp>
+#include <glm/mat3x3.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#endif
+
+#include <cstdint>
 #include <span>
+#include <string>
 #include <string_view>
+#include <vector>
 
 namespace tue::gfx {
 
@@ -28,29 +40,132 @@ struct shader_program {
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+///
+struct link_options {
+    /// Ask the driver to keep the linked binary (see `shader_cache`).
+    bool binary_retrievable{false};
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
 shader_stage make_shader_stage(std::string_view src, GLenum type) noexcept;
 
 void delete_shader_stage(shader_stage &s) noexcept;
 
-shader_program link_shader(std::span<shader_stage> stages) noexcept;
+shader_program link_shader(std::span<shader_stage> stages,
+                           link_options opts = {}) noexcept;
 
-shader_program make_shader(std::string_view vs_src,
-                           std::string_view fs_src) noexcept;
+shader_program make_shader(std::string_view vs_src, std::string_view fs_src,
+                           link_options opts = {}) noexcept;
 
 void delete_shader(shader_program &s) noexcept;
 
+std::string info_log(shader_stage s);
+
+std::string info_log(shader_program p);
+
 GLint find_uniform(shader_program p, std::string_view name) noexcept;
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+///
+struct uniform_key {
+    std::uint32_t hash{0};
+
+    friend constexpr bool operator==(uniform_key, uniform_key) noexcept = default;
+    friend constexpr auto operator<=>(uniform_key, uniform_key) noexcept = default;
+};
+
+/// FNV-1a of the uniform name; usable at compile time.
+constexpr uniform_key make_uniform_key(std::string_view name) noexcept {
+    std::uint32_t h = 0x811c9dc5U;
+    for (char c : name) {
+        h = (h ^ static_cast<unsigned char>(c)) * 0x01000193U;
+    }
+    return uniform_key{h};
+}
+
+///
+struct uniform_info {
+    uniform_key key{};
+    GLint location{-1};
+    GLenum type{GL_NONE};
+    GLint count{0};
+};
+
+/// Active default-block uniforms of a program, sorted by key.
+struct uniform_table {
+    std::vector<uniform_info> entries;
+
+    const uniform_info *find(uniform_key key) const noexcept;
+
+    GLint location(uniform_key key) const noexcept {
+        const auto *u = find(key);
+        return u != nullptr ? u->location : -1;
+    }
+
+    GLint location(std::string_view name) const noexcept {
+        return location(make_uniform_key(name));
+    }
+};
+
+/// Queries the program interface once; meant to be called right after link.
+uniform_table reflect_uniforms(shader_program p);
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
 template <typename T>
 void bind_uniform(shader_program p, GLint location, T &&value) = delete;
 
-// void bind_uniform(shader_program p, GLint location, GLint value) {
-//     glUniform1i(location, value);
-// }
-//
-// void bind_uniform(shader_program p, GLint location, GLfloat value) {
-//     glUniform1f(location, value);
-// }
+inline void bind_uniform(shader_program p, GLint location, GLint value) {
+    glProgramUniform1i(p.id, location, value);
+}
+
+inline void bind_uniform(shader_program p, GLint location, GLuint value) {
+    glProgramUniform1ui(p.id, location, value);
+}
+
+inline void bind_uniform(shader_program p, GLint location, GLfloat value) {
+    glProgramUniform1f(p.id, location, value);
+}
+
+#if defined(TUE_HAS_GLM)
+
+inline void bind_uniform(shader_program p, GLint location, glm::vec2 value) {
+    glProgramUniform2fv(p.id, location, 1, glm::value_ptr(value));
+}
+
+inline void bind_uniform(shader_program p, GLint location, glm::vec3 value) {
+    glProgramUniform3fv(p.id, location, 1, glm::value_ptr(value));
+}
+
+inline void bind_uniform(shader_program p, GLint location, glm::vec4 value) {
+    glProgramUniform4fv(p.id, location, 1, glm::value_ptr(value));
+}
+
+inline void bind_uniform(shader_program p, GLint location, glm::ivec2 value) {
+    glProgramUniform2iv(p.id, location, 1, glm::value_ptr(value));
+}
+
+inline void bind_uniform(shader_program p, GLint location, glm::ivec3 value) {
+    glProgramUniform3iv(p.id, location, 1, glm::value_ptr(value));
+}
+
+inline void bind_uniform(shader_program p, GLint location, glm::ivec4 value) {
+    glProgramUniform4iv(p.id, location, 1, glm::value_ptr(value));
+}
+
+inline void bind_uniform(shader_program p, GLint location, glm::mat3 value) {
+    glProgramUniformMatrix3fv(p.id, location, 1, GL_FALSE,
+                              glm::value_ptr(value));
+}
+
+inline void bind_uniform(shader_program p, GLint location, glm::mat4 value) {
+    glProgramUniformMatrix4fv(p.id, location, 1, GL_FALSE,
+                              glm::value_ptr(value));
+}
+
+#endif
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
@@ -61,7 +176,13 @@ void bind_uniform(shader_program p, std::string_view name, T &&value) {
     bind_uniform(p, loc, std::forward<T>(value));
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template <typename T>
+void bind_uniform(shader_program p, const uniform_table &t, uniform_key key,
+                  T &&value) {
+    GLint loc = t.location(key);
+    tue_assert(loc >= 0);
+    bind_uniform(p, loc, std::forward<T>(value));
+}
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
@@ -0,0 +1,81 @@
+#ifndef _TUE_GFX_SHADER_CACHE_HPP_INCLUDED_
+#define _TUE_GFX_SHADER_CACHE_HPP_INCLUDED_
+
+#include <tuesday/gfx/shader.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <initializer_list>
+#include <string_view>
+
+namespace tue::gfx {
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+///
+struct shader_cache_key {
+    std::uint64_t hash{0};
+
+    explicit constexpr operator bool() const noexcept { return hash != 0; }
+
+    friend constexpr bool operator==(shader_cache_key,
+                                     shader_cache_key) noexcept = default;
+};
+
+///
+struct shader_cache_stats {
+    std::size_t hits{0};
+    std::size_t misses{0};
+    std::size_t stores{0};
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+/// On-disk cache of linked program binaries (`glGetProgramBinary`).
+///
+/// Keys combine the hash of all stage sources with the identity of the GL
+/// implementation (vendor, renderer, version), so a driver update silently
+/// invalidates old entries. Must be created with a current GL context.
+class shader_cache {
+  public:
+    shader_cache() = default;
+    explicit shader_cache(std::filesystem::path dir);
+
+  public:
+    /// False if there is no cache directory or the driver exposes no
+    /// program binary formats; every lookup then falls back to compiling.
+    bool enabled() const noexcept { return m_enabled; }
+
+    const std::filesystem::path &directory() const noexcept { return m_dir; }
+
+    shader_cache_stats stats() const noexcept { return m_stats; }
+
+  public:
+    shader_cache_key
+    make_key(std::initializer_list<std::string_view> sources) const noexcept;
+
+    /// Returns an empty program if there is no (valid) entry for the key.
+    shader_program load(shader_cache_key key) noexcept;
+
+    /// The program must be linked with `link_options::binary_retrievable`.
+    bool store(shader_cache_key key, shader_program p) noexcept;
+
+    /// Same as `tue::gfx::make_shader` but served from the cache if possible.
+    shader_program make_shader(std::string_view vs_src,
+                               std::string_view fs_src) noexcept;
+
+  private:
+    std::filesystem::path entry_path(shader_cache_key key) const;
+
+  private:
+    std::filesystem::path m_dir;
+    std::uint64_t m_context_hash{0};
+    shader_cache_stats m_stats{};
+    bool m_enabled{false};
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+} // namespace tue::gfx
+
+#endif
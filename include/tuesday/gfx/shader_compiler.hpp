@@ -0,0 +1,98 @@
+#ifndef _TUE_GFX_SHADER_COMPILER_HPP_INCLUDED_
+#define _TUE_GFX_SHADER_COMPILER_HPP_INCLUDED_
+
+#include <tuesday/gfx/shader.hpp>
+#include <tuesday/gfx/shader_cache.hpp>
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace tue::gfx {
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+/// Job slots are reused once taken; `gen` tells a stale handle apart.
+struct shader_job {
+    std::uint32_t id{0};
+    std::uint32_t gen{0};
+
+    explicit constexpr operator bool() const noexcept { return id != 0; }
+};
+
+///
+enum class shader_job_status : std::uint8_t {
+    unknown, // not a job of this compiler, or already taken
+    pending,
+    ready,
+    failed,
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+/// Batched, non-blocking program compilation.
+///
+/// `submit` issues compile and link commands without querying their status,
+/// so the driver is free to compile in the background. With
+/// `GL_KHR_parallel_shader_compile` (or the ARB variant) `poll` checks
+/// `GL_COMPLETION_STATUS_KHR` and never blocks. Without it, `poll` finishes
+/// at most one job per call, so a loading loop keeps running between them.
+///
+/// All calls must be made on the thread owning the GL context.
+class shader_compiler {
+  public:
+    shader_compiler() noexcept;
+    explicit shader_compiler(shader_cache &cache) noexcept;
+    ~shader_compiler();
+
+    shader_compiler(const shader_compiler &) = delete;
+    shader_compiler &operator=(const shader_compiler &) = delete;
+
+  public:
+    /// True if the driver reports completion without blocking.
+    bool parallel() const noexcept { return m_parallel; }
+
+    std::size_t pending() const noexcept { return m_pending.size(); }
+
+  public:
+    shader_job submit(std::string_view vs_src, std::string_view fs_src);
+
+    /// Finalizes completed jobs; returns the number of jobs still pending.
+    std::size_t poll() noexcept;
+
+    /// Blocks until every submitted job is finalized.
+    void wait_all() noexcept;
+
+    shader_job_status status(shader_job job) const noexcept;
+
+    /// Hands the program over to the caller (blocks if still pending).
+    /// Failed jobs yield an empty program.
+    shader_program take(shader_job job) noexcept;
+
+  private:
+    struct job_data {
+        shader_job_status status{shader_job_status::unknown};
+        shader_stage vs{};
+        shader_stage fs{};
+        shader_program prog{};
+        shader_cache_key key{};
+        std::uint32_t gen{0};
+    };
+
+    bool is_complete(const job_data &job) const noexcept;
+    void finalize(job_data &job) noexcept;
+    job_data *find(shader_job job) noexcept;
+
+  private:
+    shader_cache *m_cache{nullptr};
+    std::vector<job_data> m_jobs;
+    std::vector<std::uint32_t> m_pending;
+    std::vector<std::uint32_t> m_free; // slots of taken jobs
+    bool m_parallel{false};
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+} // namespace tue::gfx
+
+#endif
@@ -0,0 +1,262 @@
+#ifndef _TUE_GFX_STATE_CACHE_HPP_INCLUDED_
+#define _TUE_GFX_STATE_CACHE_HPP_INCLUDED_
+
+#include <tuesday/assert.hpp>
+#include <tuesday/gfx/gl.hpp>
+#include <tuesday/gfx/shader.hpp>
+#include <tuesday/gfx/vertex_array.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace tue::gfx {
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+///
+struct state_stats {
+    std::size_t calls{0};    // state changes requested
+    std::size_t filtered{0}; // redundant ones, not forwarded to GL
+
+    constexpr std::size_t issued() const noexcept { return calls - filtered; }
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+/// Shadow copy of the GL state touched by the renderer.
+///
+/// Every setter forwards to GL only if the value differs from the tracked
+/// one. The state starts (and becomes after `invalidate`) unknown, so the
+/// first call always reaches GL. Code that changes GL state behind the
+/// cache's back must call `invalidate`; deleted objects must be forgotten,
+/// since GL may hand out the same name again.
+class state_cache {
+  public:
+    static constexpr std::size_t max_texture_units = 32;
+    static constexpr std::size_t max_indexed_buffers = 16;
+
+  public:
+    state_cache() noexcept { invalidate(); }
+
+    /// Starts a new frame: current counters become `frame_stats()`.
+    void begin_frame() noexcept {
+        m_last = m_stats;
+        m_stats = {};
+    }
+
+    /// Counters of the previous frame.
+    state_stats frame_stats() const noexcept { return m_last; }
+
+    void invalidate() noexcept {
+        m_program = unknown;
+        m_vao = unknown;
+        m_buffers.fill(unknown);
+        for (auto &ib : m_indexed) {
+            ib.fill(unknown);
+        }
+        m_textures.fill(unknown);
+        m_caps.fill(cap_unknown);
+        m_blend = {unknown, unknown};
+        m_depth_func = unknown;
+        m_depth_mask = cap_unknown;
+        m_cull_face = unknown;
+        m_viewport = {-1, -1, -1, -1};
+    }
+
+  public:
+    void use_program(shader_program p) noexcept {
+        if (change(m_program, p.id)) {
+            glUseProgram(p.id);
+        }
+    }
+
+    void bind_vertex_array(vertex_array vao) noexcept {
+        if (change(m_vao, vao.id)) {
+            glBindVertexArray(vao.id);
+            // the element buffer binding is part of the VAO state
+            m_buffers[element_slot] = unknown;
+        }
+    }
+
+    void bind_buffer(GLenum target, GLuint id) noexcept {
+        const auto slot = buffer_slot(target);
+        if (slot != no_slot ? change(m_buffers[slot], id) : untracked()) {
+            glBindBuffer(target, id);
+        }
+    }
+
+    void bind_buffer_base(GLenum target, GLuint index, GLuint id) noexcept {
+        const auto slot = indexed_slot(target);
+        const bool tracked = slot != no_slot && index < max_indexed_buffers;
+        if (tracked ? change(m_indexed[slot][index], id) : untracked()) {
+            glBindBufferBase(target, index, id);
+            // also updates the generic binding point of the target
+            if (const auto gs = buffer_slot(target); gs != no_slot) {
+                m_buffers[gs] = id;
+            }
+        }
+    }
+
+    void bind_texture_unit(GLuint unit, GLuint id) noexcept {
+        const bool tracked = unit < max_texture_units;
+        if (tracked ? change(m_textures[unit], id) : untracked()) {
+            glBindTextureUnit(unit, id);
+        }
+    }
+
+    void set_enabled(GLenum cap, bool enabled) noexcept {
+        const auto slot = cap_slot(cap);
+        const auto v = static_cast<std::int8_t>(enabled ? 1 : 0);
+        if (slot != no_slot ? change(m_caps[slot], v) : untracked()) {
+            enabled ? glEnable(cap) : glDisable(cap);
+        }
+    }
+
+    void blend_func(GLenum src, GLenum dst) noexcept {
+        if (change(m_blend, std::array<GLenum, 2>{src, dst})) {
+            glBlendFunc(src, dst);
+        }
+    }
+
+    void depth_func(GLenum func) noexcept {
+        if (change(m_depth_func, func)) {
+            glDepthFunc(func);
+        }
+    }
+
+    void depth_mask(bool write) noexcept {
+        if (change(m_depth_mask, static_cast<std::int8_t>(write ? 1 : 0))) {
+            glDepthMask(write ? GL_TRUE : GL_FALSE);
+        }
+    }
+
+    void cull_face(GLenum mode) noexcept {
+        if (change(m_cull_face, mode)) {
+            glCullFace(mode);
+        }
+    }
+
+    void viewport(GLint x, GLint y, GLsizei w, GLsizei h) noexcept {
+        if (change(m_viewport, std::array<GLint, 4>{x, y, w, h})) {
+            glViewport(x, y, w, h);
+        }
+    }
+
+  public:
+    void forget_program(GLuint id) noexcept { forget(m_program, id); }
+    void forget_vertex_array(GLuint id) noexcept { forget(m_vao, id); }
+
+    void forget_buffer(GLuint id) noexcept {
+        for (auto &b : m_buffers) {
+            forget(b, id);
+        }
+        for (auto &ib : m_indexed) {
+            for (auto &b : ib) {
+                forget(b, id);
+            }
+        }
+    }
+
+    void forget_texture(GLuint id) noexcept {
+        for (auto &t : m_textures) {
+            forget(t, id);
+        }
+    }
+
+  private:
+    static constexpr GLuint unknown = ~GLuint{0};
+    static constexpr std::int8_t cap_unknown = -1;
+    static constexpr std::size_t no_slot = ~std::size_t{0};
+    static constexpr std::size_t element_slot = 1;
+
+    static constexpr std::size_t buffer_slot(GLenum target) noexcept {
+        switch (target) {
+        case GL_ARRAY_BUFFER:
+            return 0;
+        case GL_ELEMENT_ARRAY_BUFFER:
+            return element_slot;
+        case GL_UNIFORM_BUFFER:
+            return 2;
+        case GL_SHADER_STORAGE_BUFFER:
+            return 3;
+        case GL_DRAW_INDIRECT_BUFFER:
+            return 4;
+        case GL_COPY_READ_BUFFER:
+            return 5;
+        case GL_COPY_WRITE_BUFFER:
+            return 6;
+        case GL_PIXEL_UNPACK_BUFFER:
+            return 7;
+        }
+        return no_slot;
+    }
+
+    static constexpr std::size_t indexed_slot(GLenum target) noexcept {
+        switch (target) {
+        case GL_UNIFORM_BUFFER:
+            return 0;
+        case GL_SHADER_STORAGE_BUFFER:
+            return 1;
+        }
+        return no_slot;
+    }
+
+    static constexpr std::size_t cap_slot(GLenum cap) noexcept {
+        switch (cap) {
+        case GL_BLEND:
+            return 0;
+        case GL_DEPTH_TEST:
+            return 1;
+        case GL_CULL_FACE:
+            return 2;
+        case GL_SCISSOR_TEST:
+            return 3;
+        }
+        return no_slot;
+    }
+
+    template <typename T> bool change(T &tracked, const T &value) noexcept {
+        m_stats.calls += 1;
+        if (tracked == value) {
+            m_stats.filtered += 1;
+            return false;
+        }
+        tracked = value;
+        return true;
+    }
+
+    /// Counts a call to state the cache doesn't track: always forwarded.
+    bool untracked() noexcept {
+        m_stats.calls += 1;
+        return true;
+    }
+
+    static void forget(GLuint &tracked, GLuint id) noexcept {
+        if (tracked == id) {
+            tracked = unknown;
+        }
+    }
+
+  private:
+    GLuint m_program{unknown};
+    GLuint m_vao{unknown};
+    std::array<GLuint, 8> m_buffers{};
+    std::array<std::array<GLuint, max_indexed_buffers>, 2> m_indexed{};
+    std::array<GLuint, max_texture_units> m_textures{};
+    std::array<std::int8_t, 4> m_caps{};
+    std::array<GLenum, 2> m_blend{};
+    GLenum m_depth_func{unknown};
+    std::int8_t m_depth_mask{cap_unknown};
+    GLenum m_cull_face{unknown};
+    std::array<GLint, 4> m_viewport{};
+
+    state_stats m_stats{};
+    state_stats m_last{};
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+} // namespace tue::gfx
+
+#endif
@@ -0,0 +1,172 @@
+#ifndef _TUE_GFX_UNIFORM_BLOCK_HPP_INCLUDED_
+#define _TUE_GFX_UNIFORM_BLOCK_HPP_INCLUDED_
+
+#include <tuesday/assert.hpp>
+#include <tuesday/gfx/gl.hpp>
+
+#if defined(TUE_HAS_GLM)
+#include <glm/mat4x4.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#endif
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+namespace tue::gfx {
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+///
+struct std140_member {
+    std::size_t offset{0};
+    std::size_t size{0};
+    std::size_t align{0};
+};
+
+/// std140 size and base alignment of a member type (offset is left 0).
+template <typename T> struct std140_type_fn;
+///
+template <typename T>
+static constexpr auto std140_type_for = std140_type_fn<T>{}();
+
+/// Member list of a uniform block struct, built with `TUE_STD140_MEMBER`.
+template <typename T> struct std140_layout_fn;
+///
+template <typename T>
+static constexpr auto std140_layout_for = std140_layout_fn<T>{}();
+
+///
+template <typename M>
+constexpr std140_member std140_member_of(std::size_t offset) noexcept {
+    auto m = std140_type_for<M>;
+    m.offset = offset;
+    return m;
+}
+
+#define TUE_STD140_MEMBER(T, m)                                                \
+    ::tue::gfx::std140_member_of<std::remove_cvref_t<decltype(T::m)>>(         \
+        offsetof(T, m))
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+namespace details {
+
+constexpr std::size_t align_up(std::size_t v, std::size_t a) noexcept {
+    return (v + a - 1) / a * a;
+}
+
+template <std::size_t Size, std::size_t Align> struct std140_basic_type {
+    constexpr auto operator()() const noexcept {
+        return std140_member{.size = Size, .align = Align};
+    }
+};
+
+} // namespace details
+
+template <> struct std140_type_fn<float> : details::std140_basic_type<4, 4> {};
+template <> struct std140_type_fn<int> : details::std140_basic_type<4, 4> {};
+template <>
+struct std140_type_fn<unsigned int> : details::std140_basic_type<4, 4> {};
+
+#if defined(TUE_HAS_GLM)
+template <>
+struct std140_type_fn<glm::vec2> : details::std140_basic_type<8, 8> {};
+template <>
+struct std140_type_fn<glm::vec3> : details::std140_basic_type<12, 16> {};
+template <>
+struct std140_type_fn<glm::vec4> : details::std140_basic_type<16, 16> {};
+template <>
+struct std140_type_fn<glm::ivec2> : details::std140_basic_type<8, 8> {};
+template <>
+struct std140_type_fn<glm::ivec3> : details::std140_basic_type<12, 16> {};
+template <>
+struct std140_type_fn<glm::ivec4> : details::std140_basic_type<16, 16> {};
+template <>
+struct std140_type_fn<glm::mat4> : details::std140_basic_type<64, 16> {};
+// glm::mat3 is intentionally missing: std140 pads its columns to vec4
+#endif
+
+/// True if `T` can be an array element as is: std140 gives array elements
+/// a 16-byte stride, so its size must already be a multiple of 16 bytes for
+/// the C++ array to match (a `float[4]` is 64 bytes in a block, not 16).
+template <typename T>
+concept std140_array_element =
+    std140_type_for<T>.size % 16 == 0 && sizeof(T) == std140_type_for<T>.size;
+
+/// Arrays are laid out with a 16-byte stride (see `std140_array_element`).
+template <typename T, std::size_t N> struct std140_type_fn<std::array<T, N>> {
+    constexpr auto operator()() const noexcept {
+        constexpr auto elem = std140_type_for<T>;
+        static_assert(std140_array_element<T>,
+                      "std140 array elements must be padded to 16 bytes");
+        return std140_member{.size = elem.size * N, .align = 16};
+    }
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+/// True if every listed member sits exactly where std140 puts it, and the
+/// struct size is the std140 block size (a multiple of 16).
+template <typename T> consteval bool is_std140_layout() {
+    if (!std::is_standard_layout_v<T> || !std::is_trivially_copyable_v<T>) {
+        return false;
+    }
+
+    std::size_t next{0};
+    for (auto m : std140_layout_for<T>) {
+        if (m.offset != details::align_up(next, m.align)) {
+            return false;
+        }
+        next = m.offset + m.size;
+    }
+
+    return sizeof(T) == details::align_up(next, 16);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+/// A UBO holding one `T`.
+template <class T> struct uniform_block {
+    static_assert(is_std140_layout<T>(),
+                  "Uniform block struct does not match std140 layout");
+
+    GLuint id{0};
+
+    explicit constexpr operator bool() const noexcept { return id != 0; }
+};
+
+template <class T> uniform_block<T> create_uniform_block(const T &init = {}) {
+    GLuint id{0};
+    glCreateBuffers(1, &id);
+    tue_assert(id != 0);
+    glNamedBufferStorage(id, sizeof(T), &init, GL_DYNAMIC_STORAGE_BIT);
+    return uniform_block<T>{.id = id};
+}
+
+template <class T>
+void update_uniform_block(uniform_block<T> ub, const T &data) {
+    tue_assert(ub.id != 0);
+    glNamedBufferSubData(ub.id, 0, sizeof(T), &data);
+}
+
+template <class T>
+void bind_uniform_block(uniform_block<T> ub, GLuint binding) {
+    tue_assert(ub.id != 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, binding, ub.id);
+}
+
+template <class T> void delete_uniform_block(uniform_block<T> &ub) {
+    if (ub) {
+        glDeleteBuffers(1, &ub.id);
+    }
+    ub = uniform_block<T>{};
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+} // namespace tue::gfx
+
+#endif
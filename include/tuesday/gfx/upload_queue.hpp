@@ -0,0 +1,135 @@
+#ifndef _TUE_GFX_UPLOAD_QUEUE_HPP_INCLUDED_
+#define _TUE_GFX_UPLOAD_QUEUE_HPP_INCLUDED_
+
+#include <tuesday/gfx/gl.hpp>
+#include <tuesday/gfx/gpu_fence.hpp>
+#include <tuesday/gfx/vertex_array.hpp>
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace tue::gfx {
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+/// A buffer filled by an upload_queue.
+struct uploaded_buffer {
+    std::uint64_t ticket{0};
+    GLuint id{0};
+    GLsizei stride{0}; // element size
+    GLintptr count{0}; // elements
+
+    vertex_buffer as_vertex_buffer() const noexcept {
+        return vertex_buffer{.id = id, .stride = stride, .count = count};
+    }
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+///
+/// Creates and fills buffers off the render thread, so that large meshes
+/// showing up mid-run don't stall a frame.
+///
+/// Uploads run on a thread of the queue's own, with a GL context sharing
+/// objects with the render thread's current (see wsi::worker_context).
+/// Each batch of uploads ends with a fence; `poll`, on the render thread,
+/// hands over the buffers of the batches whose fence has signaled, never
+/// waiting for the others. Without a context the queue runs inline: the
+/// uploads happen in `upload`, and `poll` hands them over as well.
+///
+/// A handed-over buffer must be (re)attached before use, e.g. with
+/// `bind_buffer`: GL makes changes from another context visible to the
+/// objects bound after the fence, not to those bound before.
+class upload_queue {
+  public:
+    using context_fn = std::function<void()>;
+
+  public:
+    /// Inline mode.
+    upload_queue() = default;
+
+    /// `make_current` and `release` are called on the upload thread, when
+    /// it starts and ends; the context must outlive the queue.
+    upload_queue(context_fn make_current, context_fn release);
+
+    /// Discards the uploads not handed over yet. Call with the render
+    /// context current.
+    ~upload_queue();
+
+    upload_queue(const upload_queue &) = delete;
+    upload_queue &operator=(const upload_queue &) = delete;
+
+  public:
+    bool threaded() const noexcept { return m_thread.joinable(); }
+
+    /// Queues a new buffer holding a copy of `data`; returns its ticket.
+    template <class Elem, std::size_t N>
+    std::uint64_t upload(std::span<Elem, N> data,
+                         GLenum usage = GL_STATIC_DRAW) {
+        static_assert(std::is_trivially_copyable_v<Elem>,
+                      "Must be trivially copyable");
+        return submit(std::as_bytes(std::span<const Elem, N>{data}),
+                      sizeof(Elem), usage);
+    }
+
+    std::uint64_t submit(std::span<const std::byte> bytes, GLsizei stride,
+                         GLenum usage);
+
+    /// Render thread: hands each buffer the GPU has finished filling to
+    /// `fn(const uploaded_buffer &)`, in submission order; the caller owns
+    /// it from then on. Returns the number handed over.
+    template <class Fn> std::size_t poll(Fn &&fn) {
+        collect();
+        for (const auto &b : m_ready) {
+            fn(b);
+        }
+        const auto n = m_ready.size();
+        m_ready.clear();
+        return n;
+    }
+
+    /// Uploads submitted but not handed over yet.
+    std::size_t in_flight() const;
+
+  private:
+    struct job {
+        std::uint64_t ticket{0};
+        std::vector<std::byte> bytes;
+        GLsizei stride{0};
+        GLenum usage{GL_NONE};
+    };
+
+    struct batch {
+        gpu_fence fence; // none when uploaded inline
+        std::vector<uploaded_buffer> buffers;
+    };
+
+    static uploaded_buffer run(const job &j);
+    void work(std::stop_token stop, const context_fn &make_current,
+              const context_fn &release);
+    void collect();
+
+  private:
+    mutable std::mutex m_mutex;
+    std::condition_variable_any m_wake;
+    std::vector<job> m_jobs;   // guarded by m_mutex
+    std::vector<batch> m_done; // guarded by m_mutex, oldest first
+    std::uint64_t m_last_ticket{0};
+
+    std::vector<uploaded_buffer> m_ready; // render thread only
+
+    std::jthread m_thread; // last: stopped and joined first
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+} // namespace tue::gfx
+
+#endif
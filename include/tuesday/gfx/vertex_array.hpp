@@ -4,8 +4,18 @@
 #include <tuesday/assert.hpp>
 #include <tuesday/gfx/gl.hpp>
 
+#if defined(TUE_HAS_GLM)
+#include <glm/ext/vector_uint3_sized.hpp>
+#include <glm/ext/vector_uint4_sized.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#endif
+
+#include <cstdint>
 #include <iterator>
 #include <span>
+#include <vector>
 
 namespace tue::gfx {
 
@@ -24,6 +34,44 @@ template <typename T> struct attrib_format_fn;
 template <typename T>
 static constexpr auto attrib_format_for = attrib_format_fn<T>{}();
 
+namespace details {
+
+template <GLint Size, GLenum Type, GLboolean Normalized>
+struct basic_attrib_format {
+    constexpr auto operator()() const noexcept {
+        return attrib_format{
+            .size = Size,
+            .type = Type,
+            .normalized = Normalized,
+        };
+    }
+};
+
+} // namespace details
+
+template <>
+struct attrib_format_fn<float>
+    : details::basic_attrib_format<1, GL_FLOAT, GL_FALSE> {};
+
+#if defined(TUE_HAS_GLM)
+template <>
+struct attrib_format_fn<glm::vec2>
+    : details::basic_attrib_format<2, GL_FLOAT, GL_FALSE> {};
+template <>
+struct attrib_format_fn<glm::vec3>
+    : details::basic_attrib_format<3, GL_FLOAT, GL_FALSE> {};
+template <>
+struct attrib_format_fn<glm::vec4>
+    : details::basic_attrib_format<4, GL_FLOAT, GL_FALSE> {};
+// 8-bit colors are normalized to [0, 1]
+template <>
+struct attrib_format_fn<glm::u8vec3>
+    : details::basic_attrib_format<3, GL_UNSIGNED_BYTE, GL_TRUE> {};
+template <>
+struct attrib_format_fn<glm::u8vec4>
+    : details::basic_attrib_format<4, GL_UNSIGNED_BYTE, GL_TRUE> {};
+#endif
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 ///
@@ -33,8 +81,12 @@ struct vertex_attrib_format {
     attrib_format attr{};
 };
 
-///
-template <typename T> struct vertex_attrib_format_fn;
+/// Defaults to a single attribute at location 0.
+template <typename T> struct vertex_attrib_format_fn {
+    constexpr auto operator()() const noexcept {
+        return vertex_attrib_format{.attr = attrib_format_for<T>};
+    }
+};
 ///
 template <typename T>
 static constexpr auto vertex_attrib_format_for = vertex_attrib_format_fn<T>{}();
@@ -52,6 +104,26 @@ struct vertex_buffer {
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+///
+struct index_buffer {
+    GLuint id{0};
+    GLenum type{GL_NONE}; // GL_UNSIGNED_SHORT or GL_UNSIGNED_INT
+    GLsizei count{0};
+
+    explicit constexpr operator bool() const noexcept { return id != 0; }
+};
+
+/// Smallest index type able to address `vertex_count` vertices.
+constexpr GLenum index_type_for(std::size_t vertex_count) noexcept {
+    return vertex_count <= 0x10000 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+}
+
+constexpr GLsizei index_size(GLenum type) noexcept {
+    return type == GL_UNSIGNED_SHORT ? 2 : (type == GL_UNSIGNED_INT ? 4 : 0);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
 ///
 struct vertex_array {
     GLuint id{0};
@@ -109,6 +181,39 @@ inline void delete_vertex_buffer(vertex_buffer &vbo) {
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+/// Creates an index buffer for a mesh of `vertex_count` vertices; indices
+/// are narrowed to 16 bits whenever the vertex count allows it.
+inline index_buffer create_index_buffer(std::span<const std::uint32_t> indices,
+                                        std::size_t vertex_count,
+                                        GLenum usage) {
+    index_buffer ibo{
+        .type = index_type_for(vertex_count),
+        .count = static_cast<GLsizei>(indices.size()),
+    };
+    glCreateBuffers(1, &ibo.id);
+    tue_assert(ibo.id != 0);
+
+    if (ibo.type == GL_UNSIGNED_SHORT) {
+        std::vector<std::uint16_t> narrow(indices.begin(), indices.end());
+        glNamedBufferData(ibo.id, narrow.size() * sizeof(std::uint16_t),
+                          narrow.data(), usage);
+    }
+    else {
+        glNamedBufferData(ibo.id, indices.size() * sizeof(std::uint32_t),
+                          indices.data(), usage);
+    }
+    return ibo;
+}
+
+inline void delete_index_buffer(index_buffer &ibo) {
+    if (ibo) {
+        glDeleteBuffers(1, &ibo.id);
+    }
+    ibo = index_buffer{};
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
 inline vertex_array create_vertex_array() {
     GLuint id{0};
     glCreateVertexArrays(1, &id);
@@ -163,6 +268,35 @@ inline bool bind_buffer(vertex_array vao, GLuint binding_index,
     return true;
 }
 
+/// Attaches `ibo` as the element buffer of `vao` (part of the VAO state).
+inline void bind_index_buffer(vertex_array vao, index_buffer ibo) {
+    tue_assert(vao.id != 0);
+    tue_assert(ibo.id != 0);
+    glVertexArrayElementBuffer(vao.id, ibo.id);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+/// Draws `count` indices of `ibo` starting at index `first`; the VAO with
+/// `ibo` bound must be current. A negative count means "up to the end".
+inline void draw_elements(GLenum mode, index_buffer ibo, GLint first = 0,
+                          GLsizei count = -1) {
+    tue_assert(ibo.id != 0);
+    const auto offset = static_cast<std::uintptr_t>(first) *
+                        static_cast<std::uintptr_t>(index_size(ibo.type));
+    glDrawElements(mode, count < 0 ? ibo.count - first : count, ibo.type,
+                   reinterpret_cast<const void *>(offset));
+}
+
+inline void draw_elements_instanced(GLenum mode, index_buffer ibo,
+                                    GLsizei instances, GLint base_vertex = 0,
+                                    GLuint base_instance = 0) {
+    tue_assert(ibo.id != 0);
+    glDrawElementsInstancedBaseVertexBaseInstance(
+        mode, ibo.count, ibo.type, nullptr, instances, base_vertex,
+        base_instance);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 // inline void draw_object(vertex_array vao) {
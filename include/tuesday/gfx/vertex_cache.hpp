@@ -0,0 +1,216 @@
+#ifndef _TUE_GFX_VERTEX_CACHE_HPP_INCLUDED_
+#define _TUE_GFX_VERTEX_CACHE_HPP_INCLUDED_
+
+#include <tuesday/assert.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace tue::gfx {
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+/// Average cache miss ratio of a triangle list: vertex shader invocations
+/// per triangle for a FIFO post-transform cache of `cache_size` entries.
+/// 3 is the worst case, ~0.5 the best reachable on large regular meshes.
+template <class I>
+    requires(std::unsigned_integral<std::remove_const_t<I>>)
+double acmr(std::span<I> indices, std::size_t vertex_count,
+            std::size_t cache_size = 16) {
+    tue_assert(indices.size() % 3 == 0);
+    if (indices.empty()) {
+        return 0.0;
+    }
+
+    // a vertex is cached if fewer than `cache_size` misses happened after
+    // it was loaded (that is exactly FIFO replacement)
+    constexpr auto never = ~std::size_t{0};
+    std::vector<std::size_t> loaded_at(vertex_count, never);
+    std::size_t misses{0};
+    for (auto i : indices) {
+        tue_assert(i < vertex_count);
+        if (loaded_at[i] == never || misses - loaded_at[i] >= cache_size) {
+            loaded_at[i] = misses++;
+        }
+    }
+
+    return static_cast<double>(misses) /
+           static_cast<double>(indices.size() / 3);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+namespace details {
+
+/// Size of the LRU cache modelled by the optimizer.
+constexpr std::size_t forsyth_cache_size = 32;
+
+/// Vertex score from T. Forsyth, "Linear-Speed Vertex Cache Optimisation".
+inline float forsyth_vertex_score(int cache_pos,
+                                  std::uint32_t remaining) noexcept {
+    if (remaining == 0) {
+        return -1.F; // no triangle needs it anymore
+    }
+
+    float score{0.F};
+    if (cache_pos >= 0) {
+        if (cache_pos < 3) {
+            // used by the last triangle: fixed score, so that the next pick
+            // does not depend on the winding of the previous one
+            score = 0.75F;
+        }
+        else {
+            constexpr auto scale = 1.F / float(forsyth_cache_size - 3);
+            score = std::pow(1.F - float(cache_pos - 3) * scale, 1.5F);
+        }
+    }
+
+    // boost vertices with few triangles left, to avoid leaving lone ones
+    return score + 2.F / std::sqrt(float(remaining));
+}
+
+} // namespace details
+
+/// Reorders the triangles of an indexed triangle list in place so that
+/// consecutive triangles share vertices (Forsyth's greedy algorithm).
+///
+/// Runs in linear time and is meant for offline / load-time use; the
+/// winding of each triangle is preserved.
+template <std::unsigned_integral I>
+void optimize_vertex_cache(std::span<I> indices, std::size_t vertex_count) {
+    constexpr auto cache_size = details::forsyth_cache_size;
+    constexpr auto none = ~std::size_t{0};
+
+    tue_assert(indices.size() % 3 == 0);
+    const std::size_t tri_count = indices.size() / 3;
+    if (tri_count < 2) {
+        return;
+    }
+
+    // triangles of each vertex, live ones in [offsets[v], +remaining[v])
+    std::vector<std::uint32_t> remaining(vertex_count, 0);
+    for (auto i : indices) {
+        tue_assert(i < vertex_count);
+        remaining[i] += 1;
+    }
+    std::vector<std::uint32_t> offsets(vertex_count + 1, 0);
+    for (std::size_t v{0}; v < vertex_count; ++v) {
+        offsets[v + 1] = offsets[v] + remaining[v];
+    }
+    std::vector<std::uint32_t> adjacency(indices.size());
+    {
+        auto fill = offsets;
+        for (std::size_t i{0}; i < indices.size(); ++i) {
+            adjacency[fill[indices[i]]++] = static_cast<std::uint32_t>(i / 3);
+        }
+    }
+
+    std::vector<int> cache_pos(vertex_count, -1);
+    std::vector<float> vscore(vertex_count);
+    for (std::size_t v{0}; v < vertex_count; ++v) {
+        vscore[v] = details::forsyth_vertex_score(-1, remaining[v]);
+    }
+
+    auto tri_score = [&](std::size_t t) {
+        return vscore[indices[t * 3 + 0]] + vscore[indices[t * 3 + 1]] +
+               vscore[indices[t * 3 + 2]];
+    };
+
+    std::vector<float> tscore(tri_count);
+    std::size_t best{0};
+    for (std::size_t t{0}; t < tri_count; ++t) {
+        tscore[t] = tri_score(t);
+        if (tscore[t] > tscore[best]) {
+            best = t;
+        }
+    }
+
+    std::vector<char> emitted(tri_count, 0);
+    std::vector<I> out;
+    out.reserve(indices.size());
+
+    std::array<std::uint32_t, cache_size + 3> cache{};
+    std::size_t cache_used{0};
+    std::size_t next_unemitted{0};
+
+    for (std::size_t n{0}; n < tri_count; ++n) {
+        if (best == none) {
+            // nothing in the cache has triangles left: restart anywhere
+            while (emitted[next_unemitted] != 0) {
+                ++next_unemitted;
+            }
+            best = next_unemitted;
+        }
+
+        emitted[best] = 1;
+        const std::array<std::uint32_t, 3> tri{
+            static_cast<std::uint32_t>(indices[best * 3 + 0]),
+            static_cast<std::uint32_t>(indices[best * 3 + 1]),
+            static_cast<std::uint32_t>(indices[best * 3 + 2]),
+        };
+
+        // the triangle's vertices move to the front of the LRU cache
+        std::array<std::uint32_t, cache_size + 3> next{};
+        std::size_t next_used{0};
+        for (auto v : tri) {
+            out.push_back(static_cast<I>(v));
+
+            auto *first = adjacency.data() + offsets[v];
+            auto *last = first + remaining[v];
+            auto *it = std::find(first, last, static_cast<std::uint32_t>(best));
+            tue_assert(it != last);
+            *it = *(last - 1);
+            remaining[v] -= 1;
+
+            if (std::find(next.begin(), next.begin() + next_used, v) ==
+                next.begin() + next_used) {
+                next[next_used++] = v;
+            }
+        }
+        for (std::size_t i{0}; i < cache_used; ++i) {
+            const auto v = cache[i];
+            if (std::ranges::find(tri, v) == tri.end()) {
+                next[next_used++] = v;
+            }
+        }
+
+        // rescore everything that moved (including vertices that fell out)
+        for (std::size_t i{0}; i < next_used; ++i) {
+            const auto v = next[i];
+            cache_pos[v] = i < cache_size ? static_cast<int>(i) : -1;
+            vscore[v] =
+                details::forsyth_vertex_score(cache_pos[v], remaining[v]);
+        }
+        cache = next;
+        cache_used = std::min(next_used, cache_size);
+
+        best = none;
+        float best_score{-1.F};
+        for (std::size_t i{0}; i < next_used; ++i) {
+            const auto v = next[i];
+            for (std::uint32_t k{0}; k < remaining[v]; ++k) {
+                const auto t = adjacency[offsets[v] + k];
+                tscore[t] = tri_score(t);
+                if (tscore[t] > best_score) {
+                    best_score = tscore[t];
+                    best = t;
+                }
+            }
+        }
+    }
+
+    std::ranges::copy(out, indices.begin());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+} // namespace tue::gfx
+
+#endif
@@ -0,0 +1,309 @@
+#ifndef _TUE_GFX_VERTEX_LAYOUT_HPP_INCLUDED_
+#define _TUE_GFX_VERTEX_LAYOUT_HPP_INCLUDED_
+
+#include <tuesday/gfx/gl.hpp>
+#include <tuesday/gfx/vertex_array.hpp>
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace tue::gfx {
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// tuesday.gfx.vertex_layout
+
+/// Interleaved attribute formats of a vertex struct, one per member, with
+/// locations 0..N-1. Derived automatically for aggregates (see below);
+/// specialize for anything else.
+template <typename V> struct vertex_layout_fn;
+///
+template <typename V>
+static constexpr auto vertex_layout_for = vertex_layout_fn<V>{}();
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+namespace details {
+
+/// Converts to anything; only used in unevaluated contexts.
+struct any_member {
+    template <typename T> constexpr operator T() const noexcept;
+};
+
+/// Number of members of an aggregate: the longest brace-init list that
+/// still compiles. `any_member` converts to any member type, so nested
+/// structs count as one member; C array members are not supported.
+template <typename T, typename... Ms> consteval std::size_t member_count() {
+    if constexpr (requires { T{Ms{}..., any_member{}}; }) {
+        return member_count<T, Ms..., any_member>();
+    }
+    else {
+        return sizeof...(Ms);
+    }
+}
+
+constexpr std::size_t max_vertex_members = 8;
+
+#define TUE_VL_TIE(...)                                                        \
+    {                                                                          \
+        auto &[__VA_ARGS__] = v;                                               \
+        return std::tie(__VA_ARGS__);                                          \
+    }
+
+template <typename T> constexpr auto tie_members(T &v) noexcept {
+    constexpr auto n = member_count<T>();
+    static_assert(n > 0 && n <= max_vertex_members,
+                  "Unsupported number of vertex members");
+
+    // clang-format off
+    if constexpr (n == 1) TUE_VL_TIE(m0)
+    else if constexpr (n == 2) TUE_VL_TIE(m0, m1)
+    else if constexpr (n == 3) TUE_VL_TIE(m0, m1, m2)
+    else if constexpr (n == 4) TUE_VL_TIE(m0, m1, m2, m3)
+    else if constexpr (n == 5) TUE_VL_TIE(m0, m1, m2, m3, m4)
+    else if constexpr (n == 6) TUE_VL_TIE(m0, m1, m2, m3, m4, m5)
+    else if constexpr (n == 7) TUE_VL_TIE(m0, m1, m2, m3, m4, m5, m6)
+    else TUE_VL_TIE(m0, m1, m2, m3, m4, m5, m6, m7)
+    // clang-format on
+}
+
+#undef TUE_VL_TIE
+
+template <typename T> struct member_types_of {
+    template <typename... Rs>
+    static auto strip(std::tuple<Rs...>)
+        -> std::tuple<std::remove_cvref_t<Rs>...>;
+
+    using type = decltype(strip(tie_members(std::declval<T &>())));
+};
+
+constexpr std::size_t align_to(std::size_t v, std::size_t a) noexcept {
+    return (v + a - 1) / a * a;
+}
+
+/// Member offsets (and the end of the last member) following the
+/// standard-layout rules, computed from sizes and alignments alone.
+template <typename... Ms> constexpr auto member_offsets() noexcept {
+    std::array<std::size_t, sizeof...(Ms) + 1> offsets{};
+    std::size_t offset{0};
+    std::size_t index{0};
+    ((offset = align_to(offset, alignof(Ms)), offsets[index++] = offset,
+      offset += sizeof(Ms)),
+     ...);
+    offsets[index] = offset;
+    return offsets;
+}
+
+template <typename V, typename... Ms>
+constexpr auto make_vertex_layout(std::tuple<Ms...> *) noexcept {
+    constexpr auto offsets = member_offsets<Ms...>();
+    static_assert(align_to(offsets.back(), alignof(V)) == sizeof(V),
+                  "Vertex struct has padding the reflection cannot predict");
+
+    std::array<vertex_attrib_format, sizeof...(Ms)> layout{};
+    std::size_t index{0};
+    ((layout[index] =
+          vertex_attrib_format{
+              .index = static_cast<GLuint>(index),
+              .offset = static_cast<GLuint>(offsets[index]),
+              .attr = attrib_format_for<Ms>,
+          },
+      ++index),
+     ...);
+    return layout;
+}
+
+} // namespace details
+
+/// Default: reflect the members of an aggregate vertex struct.
+template <typename V>
+    requires(std::is_aggregate_v<V> && std::is_standard_layout_v<V>)
+struct vertex_layout_fn<V> {
+    constexpr auto operator()() const noexcept {
+        using types = typename details::member_types_of<V>::type;
+        return details::make_vertex_layout<V>(static_cast<types *>(nullptr));
+    }
+};
+
+/// Binds the formats of `V` to `binding_index`, with the first member at
+/// `first_location`; a non-zero `divisor` makes the binding per-instance.
+template <typename V>
+void bind_vertex_layout(vertex_array vao, GLuint binding_index,
+                        GLuint first_location = 0, GLuint divisor = 0) {
+    for (auto fmt : vertex_layout_for<V>) {
+        fmt.index += first_location;
+        bind_attrib(vao, binding_index, fmt);
+    }
+    glVertexArrayBindingDivisor(vao.id, binding_index, divisor);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// GLSL vertex inputs (compile-time)
+
+///
+struct glsl_input {
+    int location{-1};
+    std::string_view type{};
+    std::string_view name{};
+};
+
+///
+struct glsl_inputs {
+    static constexpr std::size_t capacity = 16;
+
+    std::array<glsl_input, capacity> items{};
+    std::size_t size{0};
+
+    constexpr const glsl_input *find(int location) const noexcept {
+        for (std::size_t i{0}; i < size; ++i) {
+            if (items[i].location == location) {
+                return &items[i];
+            }
+        }
+        return nullptr;
+    }
+};
+
+namespace details {
+
+class glsl_lexer {
+  public:
+    constexpr explicit glsl_lexer(std::string_view src) noexcept
+        : m_src{src} {}
+
+    /// Next identifier, number or punctuation character; empty at the end.
+    constexpr std::string_view next() noexcept {
+        skip();
+        if (m_pos >= m_src.size()) {
+            return {};
+        }
+        const auto first = m_pos;
+        if (is_word(m_src[m_pos])) {
+            while (m_pos < m_src.size() && is_word(m_src[m_pos])) {
+                ++m_pos;
+            }
+        }
+        else {
+            ++m_pos;
+        }
+        return m_src.substr(first, m_pos - first);
+    }
+
+  private:
+    static constexpr bool is_word(char c) noexcept {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+               (c >= '0' && c <= '9') || c == '_';
+    }
+
+    constexpr void skip_until(std::string_view end) noexcept {
+        const auto p = m_src.find(end, m_pos);
+        m_pos = p == std::string_view::npos ? m_src.size() : p + end.size();
+    }
+
+    /// Skips blanks, comments and preprocessor lines.
+    constexpr void skip() noexcept {
+        while (m_pos < m_src.size()) {
+            const auto rest = m_src.substr(m_pos);
+            if (rest.starts_with("//") || rest.starts_with('#')) {
+                skip_until("\n");
+            }
+            else if (rest.starts_with("/*")) {
+                skip_until("*/");
+            }
+            else if (rest.front() == ' ' || rest.front() == '\t' ||
+                     rest.front() == '\n' || rest.front() == '\r') {
+                ++m_pos;
+            }
+            else {
+                break;
+            }
+        }
+    }
+
+  private:
+    std::string_view m_src;
+    std::size_t m_pos{0};
+};
+
+constexpr int parse_int(std::string_view s) noexcept {
+    int v{0};
+    for (char c : s) {
+        if (c < '0' || c > '9') {
+            return -1;
+        }
+        v = v * 10 + (c - '0');
+    }
+    return s.empty() ? -1 : v;
+}
+
+/// Number of float components of a GLSL input type, 0 if not a float type.
+constexpr int glsl_float_components(std::string_view type) noexcept {
+    if (type == "float") {
+        return 1;
+    }
+    if (type.size() == 4 && type.starts_with("vec")) {
+        const int n = type[3] - '0';
+        return n >= 2 && n <= 4 ? n : 0;
+    }
+    return 0;
+}
+
+} // namespace details
+
+/// Collects `layout (location = N) in <type> <name>;` declarations.
+constexpr glsl_inputs parse_glsl_inputs(std::string_view src) noexcept {
+    glsl_inputs out{};
+    details::glsl_lexer lex{src};
+
+    for (auto tok = lex.next(); !tok.empty(); tok = lex.next()) {
+        if (tok != "layout" || lex.next() != "(") {
+            continue;
+        }
+
+        int location{-1};
+        for (tok = lex.next(); !tok.empty() && tok != ")"; tok = lex.next()) {
+            if (tok == "location" && lex.next() == "=") {
+                location = details::parse_int(lex.next());
+            }
+        }
+
+        if (location < 0 || lex.next() != "in") {
+            continue;
+        }
+
+        const auto type = lex.next();
+        const auto name = lex.next();
+        if (out.size < glsl_inputs::capacity) {
+            out.items[out.size++] = glsl_input{location, type, name};
+        }
+    }
+
+    return out;
+}
+
+/// True if every member of `V` has a matching float input in the vertex
+/// shader `src`, at `first_location` + member index. `bind_attrib` uses
+/// `glVertexArrayAttribFormat`, so shader inputs must be float types; the
+/// component count has to match exactly.
+template <typename V>
+constexpr bool vertex_layout_matches(std::string_view src,
+                                     int first_location = 0) noexcept {
+    const auto inputs = parse_glsl_inputs(src);
+    for (const auto &fmt : vertex_layout_for<V>) {
+        const auto *in = inputs.find(first_location + int(fmt.index));
+        if (in == nullptr ||
+            details::glsl_float_components(in->type) != fmt.attr.size) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+} // namespace tue::gfx
+
+#endif
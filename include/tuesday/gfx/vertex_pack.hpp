@@ -0,0 +1,263 @@
+#ifndef _TUE_GFX_VERTEX_PACK_HPP_INCLUDED_
+#define _TUE_GFX_VERTEX_PACK_HPP_INCLUDED_
+
+#include <tuesday/assert.hpp>
+#include <tuesday/gfx/gl.hpp>
+#include <tuesday/gfx/vertex_array.hpp>
+
+#if defined(__F16C__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+namespace tue::gfx {
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// tuesday.gfx.vertex_pack
+
+/// IEEE 754 binary16 components (storage only).
+template <std::size_t N> struct half_vec {
+    std::array<std::uint16_t, N> bits{};
+};
+
+using half2 = half_vec<2>;
+using half3 = half_vec<3>;
+using half4 = half_vec<4>;
+
+/// Signed normalized 16-bit components, [-1, 1] in 1/32767 steps.
+template <std::size_t N> struct snorm16_vec {
+    std::array<std::int16_t, N> bits{};
+};
+
+using snorm16x2 = snorm16_vec<2>;
+using snorm16x3 = snorm16_vec<3>;
+using snorm16x4 = snorm16_vec<4>;
+
+/// `GL_INT_2_10_10_10_REV`: signed normalized x, y, z (10 bits) and w
+/// (2 bits) in one word; a good fit for normals and tangents.
+struct snorm_2_10_10_10 {
+    std::uint32_t bits{0};
+};
+
+template <std::size_t N>
+struct attrib_format_fn<half_vec<N>>
+    : details::basic_attrib_format<N, GL_HALF_FLOAT, GL_FALSE> {};
+
+template <std::size_t N>
+struct attrib_format_fn<snorm16_vec<N>>
+    : details::basic_attrib_format<N, GL_SHORT, GL_TRUE> {};
+
+template <>
+struct attrib_format_fn<snorm_2_10_10_10>
+    : details::basic_attrib_format<4, GL_INT_2_10_10_10_REV, GL_TRUE> {};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// scalar conversions
+
+/// Round-to-nearest-even float to half; overflow becomes infinity.
+constexpr std::uint16_t float_to_half(float f) noexcept {
+    const auto x = std::bit_cast<std::uint32_t>(f);
+    const auto sign = static_cast<std::uint16_t>((x >> 16) & 0x8000U);
+    const std::uint32_t ax = x & 0x7FFFFFFFU;
+
+    if (ax >= 0x7F800000U) { // inf, nan (kept quiet)
+        return static_cast<std::uint16_t>(
+            sign | 0x7C00U | (ax > 0x7F800000U ? 0x0200U : 0U));
+    }
+    if (ax >= 0x477FF000U) { // rounds beyond 65504
+        return static_cast<std::uint16_t>(sign | 0x7C00U);
+    }
+    if (ax < 0x38800000U) { // below the smallest normal half, 2^-14
+        if (ax < 0x33000000U) {
+            return sign; // at most half of the smallest denormal
+        }
+        const std::uint32_t e = ax >> 23;
+        const std::uint32_t m = (ax & 0x7FFFFFU) | 0x800000U;
+        const std::uint32_t shift = 126 - e;
+        const std::uint32_t half_ulp = 1U << (shift - 1);
+        const std::uint32_t rem = m & ((1U << shift) - 1);
+        std::uint32_t h = m >> shift;
+        if (rem > half_ulp || (rem == half_ulp && (h & 1U) != 0)) {
+            h += 1; // may carry into the smallest normal, which is correct
+        }
+        return static_cast<std::uint16_t>(sign | h);
+    }
+
+    // rebias the exponent (127 -> 15) and round away 13 mantissa bits
+    std::uint32_t h = (ax - 0x38000000U) >> 13;
+    const std::uint32_t rem = ax & 0x1FFFU;
+    if (rem > 0x1000U || (rem == 0x1000U && (h & 1U) != 0)) {
+        h += 1;
+    }
+    return static_cast<std::uint16_t>(sign | h);
+}
+
+constexpr float half_to_float(std::uint16_t h) noexcept {
+    const std::uint32_t sign = std::uint32_t{h & 0x8000U} << 16;
+    const std::uint32_t e = (h >> 10) & 0x1FU;
+    const std::uint32_t m = h & 0x3FFU;
+
+    if (e == 0x1F) {
+        return std::bit_cast<float>(sign | 0x7F800000U | (m << 13));
+    }
+    if (e == 0) {
+        const float v = float(m) * 0x1p-24F;
+        return sign != 0 ? -v : v;
+    }
+    return std::bit_cast<float>(sign | ((e + 112) << 23) | (m << 13));
+}
+
+namespace details {
+
+constexpr float clamp_snorm(float f) noexcept {
+    // also maps nan to 0
+    return f > 1.F ? 1.F : (f < -1.F ? -1.F : (f == f ? f : 0.F));
+}
+
+/// Rounds half away from zero, like the SIMD kernels below.
+constexpr std::int32_t round_snorm(float f, float scale) noexcept {
+    const float t = clamp_snorm(f) * scale;
+    return static_cast<std::int32_t>(t + (t < 0.F ? -0.5F : 0.5F));
+}
+
+} // namespace details
+
+constexpr std::int16_t float_to_snorm16(float f) noexcept {
+    return static_cast<std::int16_t>(details::round_snorm(f, 32767.F));
+}
+
+constexpr float snorm16_to_float(std::int16_t v) noexcept {
+    const float f = float(v) / 32767.F;
+    return f < -1.F ? -1.F : f;
+}
+
+constexpr snorm_2_10_10_10 pack_snorm_2_10_10_10(float x, float y, float z,
+                                                 float w = 0.F) noexcept {
+    const auto field = [](float f, float scale, std::uint32_t mask) {
+        return static_cast<std::uint32_t>(details::round_snorm(f, scale)) &
+               mask;
+    };
+    return snorm_2_10_10_10{
+        field(x, 511.F, 0x3FFU) | (field(y, 511.F, 0x3FFU) << 10) |
+        (field(z, 511.F, 0x3FFU) << 20) | (field(w, 1.F, 0x3U) << 30)};
+}
+
+constexpr std::array<float, 4>
+unpack_snorm_2_10_10_10(snorm_2_10_10_10 p) noexcept {
+    const auto field = [](std::uint32_t bits, int width, float scale) {
+        // sign-extend the field
+        const auto shift = 32 - width;
+        const auto v = static_cast<std::int32_t>(bits << shift) >> shift;
+        const float f = float(v) / scale;
+        return f < -1.F ? -1.F : f;
+    };
+    return {field(p.bits, 10, 511.F), field(p.bits >> 10, 10, 511.F),
+            field(p.bits >> 20, 10, 511.F), field(p.bits >> 30, 2, 1.F)};
+}
+
+template <std::size_t N>
+constexpr half_vec<N> to_half(const std::array<float, N> &v) noexcept {
+    half_vec<N> out{};
+    for (std::size_t i{0}; i < N; ++i) {
+        out.bits[i] = float_to_half(v[i]);
+    }
+    return out;
+}
+
+template <std::size_t N>
+constexpr snorm16_vec<N> to_snorm16(const std::array<float, N> &v) noexcept {
+    snorm16_vec<N> out{};
+    for (std::size_t i{0}; i < N; ++i) {
+        out.bits[i] = float_to_snorm16(v[i]);
+    }
+    return out;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// bulk conversions
+
+/// Converts `in` to halves; eight at a time with F16C (`-mf16c`, see the
+/// TUE_F16C option).
+inline void float_to_half(std::span<const float> in,
+                          std::span<std::uint16_t> out) noexcept {
+    tue_assert(out.size() >= in.size());
+
+    std::size_t i{0};
+#if defined(__F16C__)
+    for (; i + 8 <= in.size(); i += 8) {
+        const __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(in.data() + i),
+                                          _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out.data() + i), h);
+    }
+#endif
+    for (; i < in.size(); ++i) {
+        out[i] = float_to_half(in[i]);
+    }
+}
+
+/// Converts `in` to signed normalized 16-bit values (SSE2 when available).
+inline void float_to_snorm16(std::span<const float> in,
+                             std::span<std::int16_t> out) noexcept {
+    tue_assert(out.size() >= in.size());
+
+    std::size_t i{0};
+#if defined(__SSE2__)
+    const __m128 lo = _mm_set1_ps(-1.F);
+    const __m128 hi = _mm_set1_ps(1.F);
+    const __m128 scale = _mm_set1_ps(32767.F);
+    const __m128 half = _mm_set1_ps(0.5F);
+    const __m128 sign_mask = _mm_set1_ps(-0.F);
+
+    const auto convert4 = [&](const float *p) {
+        // zero nan first (min/max would turn it into a bound)
+        __m128 v = _mm_loadu_ps(p);
+        v = _mm_and_ps(v, _mm_cmpeq_ps(v, v));
+        v = _mm_mul_ps(_mm_min_ps(_mm_max_ps(v, lo), hi), scale);
+        // round half away from zero, then truncate
+        v = _mm_add_ps(v, _mm_or_ps(half, _mm_and_ps(v, sign_mask)));
+        return _mm_cvttps_epi32(v);
+    };
+
+    for (; i + 8 <= in.size(); i += 8) {
+        const __m128i a = convert4(in.data() + i);
+        const __m128i b = convert4(in.data() + i + 4);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out.data() + i),
+                         _mm_packs_epi32(a, b));
+    }
+#endif
+    for (; i < in.size(); ++i) {
+        out[i] = float_to_snorm16(in[i]);
+    }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// GPU mirror format policy
+
+/// Converts a CPU-side value to what its GPU mirror stores; the mirror's
+/// member type is `gpu_format_t<T>`. Identity by default, specialize to
+/// store a component compressed, e.g. positions as `half3`.
+template <typename T> struct gpu_format_fn {
+    constexpr T operator()(const T &v) const noexcept { return v; }
+};
+
+///
+template <typename T>
+using gpu_format_t = std::invoke_result_t<gpu_format_fn<T>, const T &>;
+
+///
+template <typename T>
+constexpr gpu_format_t<T> to_gpu_format(const T &v) noexcept {
+    return gpu_format_fn<T>{}(v);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+} // namespace tue::gfx
+
+#endif
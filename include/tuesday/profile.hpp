@@ -0,0 +1,273 @@
+#ifndef _TUE_PROFILE_HPP_INCLUDED_
+#define _TUE_PROFILE_HPP_INCLUDED_
+
+///
+/// CPU scope profiler.
+///
+/// `tue_profile_scope("name")` records the lifetime of the enclosing scope
+/// on the calling thread; `name` must be a string literal (or outlive the
+/// export). Recording is off until `tue::profile::set_enabled(true)`; with
+/// `TUE_PROFILE_NOOP` defined the macro expands to nothing at all, like
+/// `tue_assert` under `TUE_ASSERT_NOOP`.
+///
+/// Scope names read `module.component.op`, e.g. "gfx.draw_queue.execute".
+///
+/// Each thread writes into its own lock-free SPSC ring; `drain` collects
+/// the rings from any thread, and `write_chrome_trace` exports the events
+/// as Chrome trace JSON (also read by Perfetto).
+///
+
+#ifdef TUE_PROFILE_NOOP
+
+#define tue_profile_scope(name) static_cast<void>(0)
+
+#else
+
+#define TUE_PROFILE_CAT_(a, b) a##b
+#define TUE_PROFILE_CAT(a, b) TUE_PROFILE_CAT_(a, b)
+
+#define tue_profile_scope(name)                                                \
+    const ::tue::profile::scope TUE_PROFILE_CAT(tue_profile_scope_,            \
+                                                __LINE__) {                    \
+        name                                                                   \
+    }
+
+#endif
+
+#include <tuesday/utility/spsc_queue.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace tue::profile {
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+///
+struct event {
+    const char *name{nullptr}; // static string
+    std::uint64_t begin_ns{0}; // steady_clock
+    std::uint64_t end_ns{0};
+    std::uint32_t thread{0};
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+namespace details {
+
+inline std::uint64_t now_ns() noexcept {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+}
+
+/// One scope, written when it ends; a full ring drops whole scopes, so
+/// there are never unmatched begins.
+struct record {
+    const char *name{nullptr};
+    std::uint64_t begin_ns{0};
+    std::uint64_t end_ns{0};
+};
+
+struct thread_buffer {
+    static constexpr std::size_t capacity = 8192;
+
+    std::uint32_t id{0};
+    spsc_queue<record, capacity> ring{};
+};
+
+struct registry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<thread_buffer>> buffers;
+    std::vector<std::pair<std::uint32_t, std::string>> thread_names;
+    std::uint32_t next_id{0};
+    std::atomic<bool> enabled{false};
+    std::atomic<std::size_t> dropped{0};
+};
+
+inline registry &global() noexcept {
+    static registry r;
+    return r;
+}
+
+/// The calling thread's ring, registered on first use. The registry keeps
+/// a reference, so events of exited threads can still be drained.
+inline thread_buffer &local() {
+    thread_local const std::shared_ptr<thread_buffer> buf = [] {
+        auto &g = global();
+        auto b = std::make_shared<thread_buffer>();
+        const std::lock_guard lock{g.mutex};
+        b->id = g.next_id++;
+        g.buffers.push_back(b);
+        return b;
+    }();
+    return *buf;
+}
+
+inline void push(const char *name, std::uint64_t begin_ns,
+                 std::uint64_t end_ns) noexcept {
+    if (!local().ring.try_push(record{name, begin_ns, end_ns})) {
+        global().dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+} // namespace details
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+inline void set_enabled(bool on) noexcept {
+    details::global().enabled.store(on, std::memory_order_relaxed);
+}
+
+inline bool enabled() noexcept {
+    return details::global().enabled.load(std::memory_order_relaxed);
+}
+
+/// Scopes lost because a thread's ring was full (drain more often).
+inline std::size_t dropped() noexcept {
+    return details::global().dropped.load(std::memory_order_relaxed);
+}
+
+/// Names the calling thread in exported traces (also after it exits).
+inline void set_thread_name(std::string_view name) {
+    const auto id = details::local().id;
+    auto &g = details::global();
+    const std::lock_guard lock{g.mutex};
+    auto it = std::ranges::find(g.thread_names, id,
+                                &decltype(g.thread_names)::value_type::first);
+    if (it == g.thread_names.end()) {
+        g.thread_names.emplace_back(id, name);
+    }
+    else {
+        it->second = name;
+    }
+}
+
+///
+class scope {
+  public:
+    explicit scope(const char *name) noexcept
+        : m_name{enabled() ? name : nullptr},
+          m_begin{m_name != nullptr ? details::now_ns() : 0} {}
+
+    ~scope() {
+        if (m_name != nullptr) {
+            details::push(m_name, m_begin, details::now_ns());
+        }
+    }
+
+    scope(const scope &) = delete;
+    scope &operator=(const scope &) = delete;
+
+  private:
+    const char *m_name;
+    std::uint64_t m_begin;
+};
+
+/// Moves all recorded events into `out`; returns how many were added.
+/// May be called from any thread, and concurrently with recording.
+inline std::size_t drain(std::vector<event> &out) {
+    auto &g = details::global();
+    const std::lock_guard lock{g.mutex};
+
+    const auto before = out.size();
+    for (const auto &buf : g.buffers) {
+        buf->ring.consume_all([&](details::record r) {
+            out.push_back(event{r.name, r.begin_ns, r.end_ns, buf->id});
+        });
+    }
+
+    // buffers of exited threads are referenced only here, and now empty
+    std::erase_if(g.buffers, [](const auto &buf) {
+        return buf.use_count() == 1 && buf->ring.empty_approx();
+    });
+
+    return out.size() - before;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// export
+
+namespace details {
+
+inline void write_json_string(std::ostream &out, std::string_view s) {
+    out << '"';
+    for (char c : s) {
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        }
+        else if (static_cast<unsigned char>(c) >= 0x20) {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+/// Microseconds with nanosecond digits, without going through double.
+inline void write_us(std::ostream &out, std::uint64_t ns) {
+    const auto frac = ns % 1000;
+    out << ns / 1000 << '.' << char('0' + frac / 100)
+        << char('0' + frac / 10 % 10) << char('0' + frac % 10);
+}
+
+} // namespace details
+
+/// Writes `events` as Chrome trace JSON ("X" complete events, timestamps
+/// relative to the earliest event), with thread names as metadata.
+inline void write_chrome_trace(std::ostream &out,
+                               std::span<const event> events) {
+    std::uint64_t t0 = ~std::uint64_t{0};
+    for (const auto &e : events) {
+        t0 = std::min(t0, e.begin_ns);
+    }
+
+    out << R"({"displayTimeUnit":"ms","traceEvents":[)";
+
+    bool first{true};
+    const auto sep = [&] {
+        out << (first ? "\n" : ",\n");
+        first = false;
+    };
+
+    {
+        auto &g = details::global();
+        const std::lock_guard lock{g.mutex};
+        for (const auto &[id, name] : g.thread_names) {
+            sep();
+            out << R"({"ph":"M","name":"thread_name","pid":1,"tid":)" << id
+                << R"(,"args":{"name":)";
+            details::write_json_string(out, name);
+            out << "}}";
+        }
+    }
+
+    for (const auto &e : events) {
+        sep();
+        out << R"({"ph":"X","pid":1,"tid":)" << e.thread << R"(,"name":)";
+        details::write_json_string(out, e.name != nullptr ? e.name : "?");
+        out << R"(,"ts":)";
+        details::write_us(out, e.begin_ns - t0);
+        out << R"(,"dur":)";
+        details::write_us(out, e.end_ns - e.begin_ns);
+        out << '}';
+    }
+
+    out << "\n]}\n";
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+} // namespace tue::profile
+
+#endif
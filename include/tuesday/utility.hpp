@@ -1,6 +1,12 @@
 #ifndef _TUE_UTILITY_HPP_INCLUDED_
 #define _TUE_UTILITY_HPP_INCLUDED_
 
+#include <tuesday/utility/delegate.hpp>
+#include <tuesday/utility/histogram.hpp>
 #include <tuesday/utility/noncopyable.hpp>
+#include <tuesday/utility/precise_sleep.hpp>
+#include <tuesday/utility/radix_sort.hpp>
+#include <tuesday/utility/spsc_queue.hpp>
+#include <tuesday/utility/triple_buffer.hpp>
 
 #endif
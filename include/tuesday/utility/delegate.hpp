@@ -0,0 +1,82 @@
+#ifndef _TUE_UTILITY_DELEGATE_HPP_INCLUDED_
+#define _TUE_UTILITY_DELEGATE_HPP_INCLUDED_
+
+#include <tuesday/assert.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace tue {
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// tuesday.utility.delegate
+
+template <class Signature, std::size_t Size = 4 * sizeof(void *)>
+class delegate;
+
+///
+/// Callable wrapper that never allocates: the target lives in a buffer of
+/// `Size` bytes inside the delegate.
+///
+/// Only trivially copyable targets are accepted (function pointers, lambdas
+/// capturing pointers, references and scalars), so a delegate is itself
+/// trivially copyable and can be kept in a std::vector without any
+/// per-element bookkeeping. Targets that don't fit fail to compile rather
+/// than silently falling back to the heap.
+///
+/// As with std::function, calling through a const delegate may change the
+/// state of a mutable target.
+template <class R, class... Args, std::size_t Size>
+class delegate<R(Args...), Size> {
+  public:
+    static constexpr std::size_t capacity = Size;
+
+  public:
+    delegate() noexcept = default;
+    delegate(std::nullptr_t) noexcept {}
+
+    template <class F>
+        requires(!std::is_same_v<std::remove_cvref_t<F>, delegate> &&
+                 std::is_invocable_r_v<R, std::decay_t<F> &, Args...>)
+    delegate(F &&f) noexcept(
+        std::is_nothrow_constructible_v<std::decay_t<F>, F>) {
+        using target = std::decay_t<F>;
+        static_assert(sizeof(target) <= Size,
+                      "target too large: capture less or raise Size");
+        static_assert(alignof(target) <= alignof(std::max_align_t),
+                      "target over-aligned");
+        static_assert(std::is_trivially_copyable_v<target> &&
+                          std::is_trivially_destructible_v<target>,
+                      "target must be trivially copyable: capture by "
+                      "reference or pointer");
+
+        ::new (static_cast<void *>(m_buf)) target(std::forward<F>(f));
+        m_call = [](void *buf, Args... args) -> R {
+            return std::invoke(*std::launder(static_cast<target *>(buf)),
+                               std::forward<Args>(args)...);
+        };
+    }
+
+  public:
+    explicit operator bool() const noexcept { return m_call != nullptr; }
+
+    R operator()(Args... args) const {
+        tue_assert(m_call != nullptr, "empty delegate called");
+        return m_call(m_buf, std::forward<Args>(args)...);
+    }
+
+  private:
+    using thunk = R (*)(void *, Args...);
+
+    thunk m_call{nullptr};
+    alignas(std::max_align_t) mutable std::byte m_buf[Size]{};
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+} // namespace tue
+
+#endif
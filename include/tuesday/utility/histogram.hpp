@@ -0,0 +1,255 @@
+#ifndef _TUE_UTILITY_HISTOGRAM_HPP_INCLUDED_
+#define _TUE_UTILITY_HISTOGRAM_HPP_INCLUDED_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <limits>
+#include <string>
+#include <string_view>
+
+namespace tue {
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// tuesday.utility.histogram
+
+///
+struct histogram_summary {
+    std::uint64_t count{0};
+    std::uint64_t min{0};
+    std::uint64_t max{0};
+    double mean{0.};
+    std::uint64_t p50{0};
+    std::uint64_t p95{0};
+    std::uint64_t p99{0};
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+/// Log-linear (HDR style) histogram of unsigned integer values.
+///
+/// Values below 2^SubBits are counted exactly. Above that, every power of
+/// two is split into 2^SubBits buckets, so percentiles are accurate to a
+/// relative 2^-SubBits. Values of 2^MaxBits and more share the last bucket
+/// (`max` stays exact).
+///
+/// `record` is lock-free and may be called from any number of threads.
+/// Readers may run concurrently with it; they then see a recent, possibly
+/// slightly torn, state (e.g. `count` ahead of the buckets).
+template <unsigned SubBits = 7, unsigned MaxBits = 40> class basic_histogram {
+    static_assert(SubBits >= 1 && SubBits < MaxBits && MaxBits <= 63);
+
+  public:
+    static constexpr std::size_t sub_count = std::size_t{1} << SubBits;
+    static constexpr std::size_t bucket_count =
+        (MaxBits - SubBits + 1) * sub_count;
+    static constexpr std::uint64_t max_trackable =
+        (std::uint64_t{1} << MaxBits) - 1;
+
+    static constexpr std::size_t bucket_of(std::uint64_t v) noexcept {
+        v = std::min(v, max_trackable);
+        if (v < sub_count) {
+            return static_cast<std::size_t>(v);
+        }
+        const auto shift = static_cast<unsigned>(std::bit_width(v)) - 1 -
+                           SubBits;
+        return (shift + 1) * sub_count +
+               static_cast<std::size_t>((v >> shift) - sub_count);
+    }
+
+    /// Smallest value counted in bucket `i`.
+    static constexpr std::uint64_t bucket_lower(std::size_t i) noexcept {
+        if (i < sub_count) {
+            return i;
+        }
+        const auto shift = i / sub_count - 1;
+        return std::uint64_t{sub_count + i % sub_count} << shift;
+    }
+
+    /// Largest value counted in bucket `i`.
+    static constexpr std::uint64_t bucket_upper(std::size_t i) noexcept {
+        if (i < sub_count) {
+            return i;
+        }
+        const auto shift = i / sub_count - 1;
+        return bucket_lower(i) + ((std::uint64_t{1} << shift) - 1);
+    }
+
+  public:
+    basic_histogram() noexcept { reset(); }
+
+    basic_histogram(const basic_histogram &) = delete;
+    basic_histogram &operator=(const basic_histogram &) = delete;
+
+  public:
+    void record(std::uint64_t v, std::uint64_t n = 1) noexcept {
+        constexpr auto mo = std::memory_order_relaxed;
+        m_buckets[bucket_of(v)].fetch_add(n, mo);
+        m_count.fetch_add(n, mo);
+        m_sum.fetch_add(v * n, mo);
+
+        auto lo = m_min.load(mo);
+        while (v < lo && !m_min.compare_exchange_weak(lo, v, mo)) {
+        }
+        auto hi = m_max.load(mo);
+        while (v > hi && !m_max.compare_exchange_weak(hi, v, mo)) {
+        }
+    }
+
+    /// Adds all values of `other` (which may still be recording).
+    void merge(const basic_histogram &other) noexcept {
+        constexpr auto mo = std::memory_order_relaxed;
+        for (std::size_t i{0}; i < bucket_count; ++i) {
+            if (const auto n = other.m_buckets[i].load(mo); n != 0) {
+                m_buckets[i].fetch_add(n, mo);
+            }
+        }
+        m_count.fetch_add(other.m_count.load(mo), mo);
+        m_sum.fetch_add(other.m_sum.load(mo), mo);
+
+        const auto olo = other.m_min.load(mo);
+        auto lo = m_min.load(mo);
+        while (olo < lo && !m_min.compare_exchange_weak(lo, olo, mo)) {
+        }
+        const auto ohi = other.m_max.load(mo);
+        auto hi = m_max.load(mo);
+        while (ohi > hi && !m_max.compare_exchange_weak(hi, ohi, mo)) {
+        }
+    }
+
+    /// Values recorded concurrently with a reset may or may not survive it.
+    void reset() noexcept {
+        constexpr auto mo = std::memory_order_relaxed;
+        for (auto &b : m_buckets) {
+            b.store(0, mo);
+        }
+        m_count.store(0, mo);
+        m_sum.store(0, mo);
+        m_min.store(std::numeric_limits<std::uint64_t>::max(), mo);
+        m_max.store(0, mo);
+    }
+
+  public:
+    std::uint64_t count() const noexcept {
+        return m_count.load(std::memory_order_relaxed);
+    }
+
+    std::uint64_t min() const noexcept {
+        return count() > 0 ? m_min.load(std::memory_order_relaxed) : 0;
+    }
+
+    std::uint64_t max() const noexcept {
+        return m_max.load(std::memory_order_relaxed);
+    }
+
+    double mean() const noexcept {
+        const auto n = count();
+        return n > 0 ? double(m_sum.load(std::memory_order_relaxed)) / n
+                     : 0.;
+    }
+
+    /// Smallest value such that `p` percent of the recorded values are not
+    /// greater than it (up to the bucket precision); `p` is in [0, 100].
+    std::uint64_t percentile(double p) const noexcept {
+        const double ps[] = {p};
+        std::uint64_t out[1]{};
+        percentiles(ps, out);
+        return out[0];
+    }
+
+    histogram_summary summary() const noexcept {
+        const double ps[] = {50., 95., 99.};
+        std::uint64_t vs[3]{};
+        percentiles(ps, vs);
+        return histogram_summary{
+            .count = count(),
+            .min = min(),
+            .max = max(),
+            .mean = mean(),
+            .p50 = vs[0],
+            .p95 = vs[1],
+            .p99 = vs[2],
+        };
+    }
+
+  private:
+    /// One pass over the buckets for ascending `ps`.
+    template <std::size_t N>
+    void percentiles(const double (&ps)[N],
+                     std::uint64_t (&out)[N]) const noexcept {
+        constexpr auto mo = std::memory_order_relaxed;
+
+        std::uint64_t total{0};
+        for (const auto &b : m_buckets) {
+            total += b.load(mo);
+        }
+        if (total == 0) {
+            return;
+        }
+
+        const auto lo = min();
+        const auto hi = max();
+
+        std::size_t k{0};
+        std::uint64_t seen{0};
+        for (std::size_t i{0}; i < bucket_count && k < N; ++i) {
+            seen += m_buckets[i].load(mo);
+            for (; k < N; ++k) {
+                const double p = std::clamp(ps[k], 0., 100.);
+                const auto rank = std::max<std::uint64_t>(
+                    1, static_cast<std::uint64_t>(p / 100. * double(total) +
+                                                  0.999999));
+                if (seen < rank) {
+                    break;
+                }
+                out[k] = std::clamp(bucket_upper(i), lo, hi);
+            }
+        }
+        for (; k < N; ++k) {
+            out[k] = hi;
+        }
+    }
+
+  private:
+    std::array<std::atomic<std::uint64_t>, bucket_count> m_buckets;
+    std::atomic<std::uint64_t> m_count;
+    std::atomic<std::uint64_t> m_sum;
+    std::atomic<std::uint64_t> m_min;
+    std::atomic<std::uint64_t> m_max;
+};
+
+///
+using histogram = basic_histogram<>;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// export
+
+inline std::string to_csv_header() {
+    return "name,count,min,mean,p50,p95,p99,max";
+}
+
+/// One CSV line (without newline); `name` is written verbatim.
+inline std::string to_csv_row(std::string_view name,
+                              const histogram_summary &s) {
+    return std::format("{},{},{},{:.1f},{},{},{},{}", name, s.count, s.min,
+                       s.mean, s.p50, s.p95, s.p99, s.max);
+}
+
+/// One JSON object; `name` is written verbatim.
+inline std::string to_json(std::string_view name,
+                           const histogram_summary &s) {
+    return std::format(
+        R"({{"name":"{}","count":{},"min":{},"mean":{:.1f},"p50":{},)"
+        R"("p95":{},"p99":{},"max":{}}})",
+        name, s.count, s.min, s.mean, s.p50, s.p95, s.p99, s.max);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+} // namespace tue
+
+#endif
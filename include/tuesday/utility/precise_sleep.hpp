@@ -0,0 +1,57 @@
+#ifndef _TUE_UTILITY_PRECISE_SLEEP_HPP_INCLUDED_
+#define _TUE_UTILITY_PRECISE_SLEEP_HPP_INCLUDED_
+
+#include <chrono>
+#include <thread>
+
+#if defined(__linux__)
+#include <cerrno>
+#include <ctime>
+#endif
+
+namespace tue {
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// tuesday.utility.precise_sleep
+
+///
+/// Blocks until `deadline`, waking neither early nor (much) late.
+///
+/// The thread sleeps until `spin` before the deadline and yields for the
+/// rest, which absorbs the timer slack of the OS (typically 50us..1ms).
+/// On Linux the sleep is an absolute `clock_nanosleep` on
+/// `CLOCK_MONOTONIC` (the clock behind `steady_clock`), so interruptions
+/// and preemption do not accumulate drift.
+inline void precise_sleep_until(
+    std::chrono::steady_clock::time_point deadline,
+    std::chrono::nanoseconds spin = std::chrono::microseconds{500}) {
+    using clock = std::chrono::steady_clock;
+
+    const auto wake = deadline - spin;
+    if (clock::now() < wake) {
+#if defined(__linux__)
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            wake.time_since_epoch())
+                            .count();
+        const timespec ts{
+            .tv_sec = static_cast<std::time_t>(ns / 1'000'000'000),
+            .tv_nsec = static_cast<long>(ns % 1'000'000'000),
+        };
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) ==
+               EINTR) {
+        }
+#else
+        std::this_thread::sleep_until(wake);
+#endif
+    }
+
+    while (clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+} // namespace tue
+
+#endif
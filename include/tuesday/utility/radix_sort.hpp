@@ -0,0 +1,81 @@
+#ifndef _TUE_UTILITY_RADIX_SORT_HPP_INCLUDED_
+#define _TUE_UTILITY_RADIX_SORT_HPP_INCLUDED_
+
+#include <tuesday/assert.hpp>
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <utility>
+
+namespace tue {
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// tuesday.utility.radix_sort
+
+///
+/// Stable LSD radix sort (8-bit digits) of `items` by an unsigned key.
+///
+/// `scratch` must be at least as large as `items`. Digits shared by all keys
+/// are skipped, so keys with few distinct bytes sort in few passes.
+template <class T, class Proj = std::identity>
+    requires(std::unsigned_integral<
+             std::remove_cvref_t<std::invoke_result_t<Proj &, const T &>>>)
+void radix_sort(std::span<T> items, std::span<T> scratch, Proj proj = {}) {
+    using key_type =
+        std::remove_cvref_t<std::invoke_result_t<Proj &, const T &>>;
+    constexpr std::size_t num_digits = sizeof(key_type);
+    constexpr std::size_t radix = 256;
+
+    tue_assert(scratch.size() >= items.size(), "scratch is too small");
+
+    const auto n = items.size();
+    if (n < 2) {
+        return;
+    }
+
+    // one pass over the data builds histograms for all digits
+    std::array<std::array<std::size_t, radix>, num_digits> counts{};
+    for (const auto &item : items) {
+        const key_type k = std::invoke(proj, item);
+        for (std::size_t d{0}; d < num_digits; ++d) {
+            counts[d][(k >> (d * 8)) & 0xFF] += 1;
+        }
+    }
+
+    std::span<T> src = items;
+    std::span<T> dst = scratch.first(n);
+
+    for (std::size_t d{0}; d < num_digits; ++d) {
+        auto &cnt = counts[d];
+        const key_type k0 = std::invoke(proj, src.front());
+        if (cnt[(k0 >> (d * 8)) & 0xFF] == n) {
+            continue; // every key has the same digit
+        }
+
+        std::size_t offset{0};
+        for (auto &c : cnt) {
+            offset += std::exchange(c, offset);
+        }
+
+        for (auto &item : src) {
+            const key_type k = std::invoke(proj, item);
+            dst[cnt[(k >> (d * 8)) & 0xFF]++] = std::move(item);
+        }
+
+        std::swap(src, dst);
+    }
+
+    if (src.data() != items.data()) {
+        std::ranges::move(src, items.begin());
+    }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+} // namespace tue
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef _TUE_UTILITY_SPSC_QUEUE_HPP_INCLUDED_
+#define _TUE_UTILITY_SPSC_QUEUE_HPP_INCLUDED_
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace tue {
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// tuesday.utility.spsc_queue
+
+///
+/// Bounded lock-free queue for exactly one producer and one consumer thread.
+///
+/// Slots are preallocated (`T` must be default constructible and movable),
+/// so pushing never allocates; a full queue rejects new elements.
+template <class T, std::size_t Capacity> class spsc_queue {
+    static_assert(std::has_single_bit(Capacity),
+                  "Capacity must be a power of two");
+    static_assert(std::is_default_constructible_v<T> &&
+                  std::is_nothrow_move_assignable_v<T>);
+
+    static constexpr std::size_t mask = Capacity - 1;
+
+  public:
+    static constexpr std::size_t capacity() noexcept { return Capacity; }
+
+  public:
+    spsc_queue() = default;
+    spsc_queue(const spsc_queue &) = delete;
+    spsc_queue &operator=(const spsc_queue &) = delete;
+
+  public:
+    /// Producer side.
+    bool try_push(T value) noexcept {
+        const auto head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+        m_slots[head & mask] = std::move(value);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Consumer side.
+    bool try_pop(T &out) noexcept {
+        const auto tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_head.load(std::memory_order_acquire)) {
+            return false;
+        }
+        out = std::move(m_slots[tail & mask]);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Consumer side: hands every available element to `fn` in order, then
+    /// releases their slots at once. Returns the number of elements.
+    template <class Fn> std::size_t consume_all(Fn &&fn) {
+        const auto tail = m_tail.load(std::memory_order_relaxed);
+        const auto head = m_head.load(std::memory_order_acquire);
+        for (auto i = tail; i != head; ++i) {
+            fn(std::move(m_slots[i & mask]));
+        }
+        m_tail.store(head, std::memory_order_release);
+        return head - tail;
+    }
+
+    /// Exact only when called from one of the two sides while the other
+    /// is idle.
+    std::size_t size_approx() const noexcept {
+        return m_head.load(std::memory_order_acquire) -
+               m_tail.load(std::memory_order_acquire);
+    }
+
+    bool empty_approx() const noexcept { return size_approx() == 0; }
+
+  private:
+    // head and tail on their own cache lines, so the two sides do not
+    // invalidate each other's line on every operation
+    static constexpr std::size_t line = 64;
+
+    alignas(line) std::atomic<std::size_t> m_head{0}; // written by producer
+    alignas(line) std::atomic<std::size_t> m_tail{0}; // written by consumer
+    alignas(line) std::array<T, Capacity> m_slots{};
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+} // namespace tue
+
+#endif
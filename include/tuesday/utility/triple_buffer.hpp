@@ -0,0 +1,71 @@
+#ifndef _TUE_UTILITY_TRIPLE_BUFFER_HPP_INCLUDED_
+#define _TUE_UTILITY_TRIPLE_BUFFER_HPP_INCLUDED_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace tue {
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// tuesday.utility.triple_buffer
+
+///
+/// Lock-free hand-over of the latest value from one writer thread to one
+/// reader thread.
+///
+/// The writer fills `write_buffer()` and `publish`es it; the reader calls
+/// `update()` and then reads `read_buffer()`, which stays untouched by the
+/// writer until the next `update()`. Neither side ever waits: the writer
+/// may publish faster than the reader updates (older values are skipped),
+/// and the reader keeps the last value while nothing new is published.
+///
+/// Buffers are reused, so a `T` holding containers stops allocating once
+/// all three have grown to size. The values start default constructed; a
+/// buffer handed back to the writer holds whatever it held before.
+template <class T> class triple_buffer {
+  public:
+    triple_buffer() = default;
+    triple_buffer(const triple_buffer &) = delete;
+    triple_buffer &operator=(const triple_buffer &) = delete;
+
+  public:
+    /// Writer side: the buffer to fill next.
+    T &write_buffer() noexcept { return m_buffers[m_write]; }
+
+    /// Writer side: makes the write buffer the latest value.
+    void publish() noexcept {
+        const auto prev = m_back.exchange(m_write | fresh_bit,
+                                          std::memory_order_acq_rel);
+        m_write = prev & index_mask;
+    }
+
+    /// Reader side: switches to the latest value; false if there is none
+    /// newer than the current read buffer.
+    bool update() noexcept {
+        if ((m_back.load(std::memory_order_relaxed) & fresh_bit) == 0) {
+            return false;
+        }
+        const auto prev = m_back.exchange(m_read, std::memory_order_acq_rel);
+        m_read = prev & index_mask;
+        return true;
+    }
+
+    /// Reader side.
+    const T &read_buffer() const noexcept { return m_buffers[m_read]; }
+
+  private:
+    static constexpr std::uint8_t index_mask = 0x3;
+    static constexpr std::uint8_t fresh_bit = 0x4;
+
+    std::array<T, 3> m_buffers{};
+    std::uint8_t m_write{0};             // owned by the writer
+    std::atomic<std::uint8_t> m_back{1}; // index, and whether unread
+    std::uint8_t m_read{2};              // owned by the reader
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+} // namespace tue
+
+#endif
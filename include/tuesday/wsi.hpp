@@ -1,12 +1,20 @@
 #ifndef _TUE_WSI_HPP_INCLUDED_
 #define _TUE_WSI_HPP_INCLUDED_
 
+#include <tuesday/wsi/frame_pacer.hpp>
 #include <tuesday/wsi/window.hpp>
 
 namespace tue::wsi {
 
-window_system connect();
+///
+struct connect_options {
+    /// No display: windows are offscreen, GL contexts come from EGL
+    /// (surfaceless/pbuffer) or OSMesa. For CI and benchmark runs.
+    bool headless{false};
+};
 
-}
+window_system connect(connect_options opts = {});
+
+} // namespace tue::wsi
 
 #endif
@@ -0,0 +1,107 @@
+#ifndef _TUE_WSI_EVENT_QUEUE_HPP_INCLUDED_
+#define _TUE_WSI_EVENT_QUEUE_HPP_INCLUDED_
+
+#include <tuesday/utility/spsc_queue.hpp>
+#include <tuesday/wsi/window_events.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <variant>
+
+namespace tue::wsi {
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+/// A mouse event carrying only a new cursor position.
+constexpr bool is_cursor_move(const mouse_event &e) noexcept {
+    return e.code == key_code::unspec && e.act == key_action::unspec;
+}
+
+/// Whether `next` makes `prev` obsolete when they arrive back to back:
+/// only the last of consecutive resizes and cursor moves matters.
+constexpr bool coalesces(const any_event &prev, const any_event &next) {
+    if (prev.index() != next.index()) {
+        return false;
+    }
+    if (std::holds_alternative<resize_event>(next)) {
+        return true;
+    }
+    if (const auto *m = std::get_if<mouse_event>(&next)) {
+        return is_cursor_move(*m) &&
+               is_cursor_move(std::get<mouse_event>(prev));
+    }
+    return false;
+}
+
+/// Keeps in `next` what a coalesced `prev` contributed: the motion of the
+/// cursor moves it replaces.
+constexpr void absorb(any_event &next, const any_event &prev) {
+    if (auto *m = std::get_if<mouse_event>(&next)) {
+        const auto &p = std::get<mouse_event>(prev);
+        m->delta.x += p.delta.x;
+        m->delta.y += p.delta.y;
+    }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+///
+/// Preallocated queue of window events between the thread polling the
+/// platform (producer) and the one handling input (consumer).
+///
+/// Pushing never allocates or blocks; when the consumer falls behind by
+/// more than `capacity` events, new ones are dropped and counted.
+class event_queue {
+  public:
+    static constexpr std::size_t capacity = 1024;
+
+  public:
+    /// Producer side.
+    bool push(const any_event &e) noexcept {
+        if (m_queue.try_push(e)) {
+            return true;
+        }
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    /// Consumer side: hands all queued events to `fn` in order, with runs
+    /// of resizes and of cursor moves collapsed into their last event (with
+    /// the motion of the whole run as its `delta`).
+    /// Returns the number of events handed over.
+    template <class Fn> std::size_t drain(Fn &&fn) {
+        std::size_t n{0};
+        std::optional<any_event> held;
+        m_queue.consume_all([&](any_event e) {
+            if (held && coalesces(*held, e)) {
+                absorb(e, *held);
+            }
+            else if (held) {
+                fn(*held);
+                ++n;
+            }
+            held = e;
+        });
+        if (held) {
+            fn(*held);
+            ++n;
+        }
+        return n;
+    }
+
+    /// Events lost to a full queue.
+    std::size_t dropped() const noexcept {
+        return m_dropped.load(std::memory_order_relaxed);
+    }
+
+  private:
+    spsc_queue<any_event, capacity> m_queue;
+    std::atomic<std::size_t> m_dropped{0};
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+} // namespace tue::wsi
+
+#endif
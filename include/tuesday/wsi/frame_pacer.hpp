@@ -0,0 +1,114 @@
+#ifndef _TUE_WSI_FRAME_PACER_HPP_INCLUDED_
+#define _TUE_WSI_FRAME_PACER_HPP_INCLUDED_
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+namespace tue::wsi {
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+///
+/// Schedules frames to start as late as they can while still making the
+/// next vertical blank, from the history of buffer swaps and frame times.
+///
+/// With a swap interval of 1 or more, a swap returns at a vblank (or at a
+/// fixed offset from one), so the swap times give both the refresh period
+/// and its phase. Starting the next frame only `work_estimate() + margin`
+/// before the predicted vblank, rather than right after the last swap,
+/// lets it sample input that much later without missing the vblank.
+class frame_pacer {
+  public:
+    using clock = std::chrono::steady_clock;
+    using duration = clock::duration;
+    using time_point = clock::time_point;
+
+    static constexpr std::size_t history = 32;
+
+    /// Slack between the predicted end of a frame and the vblank.
+    duration margin{std::chrono::milliseconds{1}};
+
+  public:
+    /// Records when a `swap_buffers` call returned.
+    void add_swap(time_point t) noexcept {
+        if (m_last_swap != time_point{}) {
+            m_periods.add(t - m_last_swap);
+        }
+        m_last_swap = t;
+    }
+
+    /// Records how long the work of a frame took, up to its swap.
+    void add_work(duration d) noexcept { m_work.add(d); }
+
+    /// The refresh period: the median time between recent swaps, so that
+    /// a missed vblank is an outlier rather than a shift. Zero until a
+    /// quarter of the history is known.
+    duration period() const noexcept {
+        if (m_periods.count < history / 4) {
+            return duration::zero();
+        }
+        auto v = m_periods.values;
+        const auto n = m_periods.count;
+        std::nth_element(v.begin(), v.begin() + n / 2, v.begin() + n);
+        return v[n / 2];
+    }
+
+    /// The longest of the recent frames.
+    duration work_estimate() const noexcept {
+        const auto n = m_work.count;
+        return n == 0 ? duration::zero()
+                      : *std::max_element(m_work.values.begin(),
+                                          m_work.values.begin() + n);
+    }
+
+    /// The first vblank predicted after `t`; `t` itself while the period
+    /// is unknown.
+    time_point next_vblank(time_point t) const noexcept {
+        const auto p = period();
+        if (p == duration::zero() || t < m_last_swap) {
+            return std::max(t, m_last_swap);
+        }
+        return m_last_swap + ((t - m_last_swap) / p + 1) * p;
+    }
+
+    /// When to start the next frame so that it's done `margin` before the
+    /// first vblank after `t` it can still make; `t` if there's no room to
+    /// wait (or nothing to predict from yet).
+    time_point frame_start(time_point t) const noexcept {
+        const auto p = period();
+        if (p == duration::zero()) {
+            return t;
+        }
+        const auto lead = work_estimate() + margin;
+        auto start = next_vblank(t) - lead;
+        if (start < t) {
+            start += p; // too late for that one: aim for the next
+        }
+        return std::max(start, t);
+    }
+
+  private:
+    struct ring {
+        std::array<duration, history> values{};
+        std::size_t count{0};
+        std::size_t next{0};
+
+        void add(duration d) noexcept {
+            values[next] = d;
+            next = (next + 1) % history;
+            count = std::min(count + 1, history);
+        }
+    };
+
+    ring m_periods;
+    ring m_work;
+    time_point m_last_swap{};
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+} // namespace tue::wsi
+
+#endif
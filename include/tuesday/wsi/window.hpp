@@ -2,10 +2,17 @@
 #define _TUE_WSI_WINDOW_HPP_INCLUDED_
 
 #include "tuesday/wsi/window_attrs.hpp"
+#include <tuesday/utility/delegate.hpp>
+#include <tuesday/wsi/event_queue.hpp>
 #include <tuesday/wsi/window_client.hpp>
 
-#include <functional>
-#include <list>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <variant>
+#include <vector>
 
 namespace tue::wsi {
 
@@ -14,26 +21,99 @@ namespace tue::wsi {
 class window;
 class window_system;
 
-class window_watcher {
-  private:
-    friend window;
-    explicit window_watcher(window &);
+/// Handler of the window events of type `E` (see any_event).
+template <class E> using event_handler = delegate<void(window &, E)>;
 
-  public:
-    ~window_watcher();
+/// Identifies a handler added by `window::watch`, for `window::unwatch`;
+/// stays valid whatever other handlers are added or removed.
+struct watch_handle {
+    std::uint32_t kind{0};
+    std::uint32_t id{0}; // 0: no handler
+
+    explicit operator bool() const noexcept { return id != 0; }
+};
+
+namespace details {
 
+///
+/// The handlers of one event kind, contiguous and in the order added.
+///
+/// Handlers may watch and unwatch from within a call: additions wait aside
+/// and removals leave a hole until the outermost call returns, so the array
+/// never moves under a running handler.
+template <class E> class handler_list {
   public:
-    template <typename... Args> using signal = std::function<void(Args...)>;
+    std::uint32_t add(event_handler<E> fn) {
+        const auto id = ++m_last_id;
+        (m_calling > 0 ? m_added : m_entries).push_back({fn, id});
+        return id;
+    }
+
+    bool remove(std::uint32_t id) noexcept {
+        const auto match = [id](const entry &e) { return e.id == id; };
+        if (std::erase_if(m_added, match) > 0) {
+            return true;
+        }
+        auto iter = std::ranges::find_if(m_entries, match);
+        if (iter == m_entries.end()) {
+            return false;
+        }
+        if (m_calling > 0) {
+            iter->id = 0;
+            m_holes = true;
+        }
+        else {
+            m_entries.erase(iter);
+        }
+        return true;
+    }
+
+    void call(window &w, E e) {
+        ++m_calling;
+        for (const auto &h : m_entries) {
+            if (h.id != 0) {
+                h.fn(w, e);
+            }
+        }
+        if (--m_calling == 0 && (m_holes || !m_added.empty())) {
+            settle();
+        }
+    }
+
+    std::size_t size() const noexcept {
+        return m_entries.size() + m_added.size();
+    }
+
+  private:
+    struct entry {
+        event_handler<E> fn;
+        std::uint32_t id;
+    };
 
-    signal<window &, resize_event> on_size;
-    signal<window &> on_draw;
-    signal<window &, keyboard_event> on_keyboard;
-    signal<window &, mouse_event> on_mouse;
+    void settle() {
+        std::erase_if(m_entries, [](const entry &e) { return e.id == 0; });
+        m_entries.insert(m_entries.end(), m_added.begin(), m_added.end());
+        m_added.clear();
+        m_holes = false;
+    }
 
   private:
-    window *m_owner{nullptr};
+    std::vector<entry> m_entries;
+    std::vector<entry> m_added;
+    std::uint32_t m_last_id{0};
+    int m_calling{0};
+    bool m_holes{false};
 };
 
+/// One handler_list per alternative of an event variant, in its order.
+template <class Variant> struct handler_lists;
+
+template <class... Es> struct handler_lists<std::variant<Es...>> {
+    using type = std::tuple<handler_list<Es>...>;
+};
+
+} // namespace details
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 class window : public window_context {
@@ -58,8 +138,46 @@ class window : public window_context {
     window_attrs get_attrs() const noexcept { return m_attrs; }
 
   public:
-    window_watcher *make_watcher();
-    void remove_watcher(window_watcher *w);
+    /// Calls `fn(window &, E)` on each event of type `E` from now on.
+    /// Delivering an event visits only the handlers of its type.
+    template <class E> watch_handle watch(event_handler<E> fn) {
+        constexpr auto kind = any_event{std::in_place_type<E>}.index();
+        return {static_cast<std::uint32_t>(kind), handlers<E>().add(fn)};
+    }
+
+    /// Removes the handler; a no-op if it is already gone.
+    void unwatch(watch_handle h) noexcept;
+
+  public:
+    /// Queued mode: platform events are buffered (see event_queue) instead
+    /// of reaching the handlers from within `poll_events`, and are
+    /// delivered by `dispatch_events`. The window's own state, such as its
+    /// size, is still updated by `poll_events` as events arrive.
+    ///
+    /// Dispatching may run on another thread than polling, provided that
+    /// thread alone calls `watch`, `unwatch`, `dispatch_events` and
+    /// `drain_events`, and takes sizes from resize events rather than
+    /// `get_attrs`; every other member stays with the polling thread.
+    /// Switch modes only while no other thread dispatches.
+    void set_queued(bool queued);
+    bool is_queued() const noexcept { return m_queue != nullptr; }
+
+    /// Delivers the queued events to the handlers; returns their number.
+    std::size_t dispatch_events();
+
+    /// Hands the queued events to `fn(const any_event &)` instead of the
+    /// handlers.
+    template <class Fn> std::size_t drain_events(Fn &&fn) {
+        if (!m_queue) {
+            return 0;
+        }
+        return m_queue->drain(fn);
+    }
+
+    /// Events dropped because the queue was full.
+    std::size_t dropped_events() const noexcept {
+        return m_queue ? m_queue->dropped() : 0;
+    }
 
   public:
     void set_client(std::unique_ptr<window_client>);
@@ -72,34 +190,109 @@ class window : public window_context {
     window_pos get_normal_pos() const noexcept override;
     window_size get_normal_size() const noexcept override;
     window_mode get_default_mode() const noexcept override;
+    cursor_mode get_cursor_mode() const noexcept override;
+    swap_interval get_swap_interval() const noexcept override;
     void on_event(resize_event e) noexcept override;
     void on_event(redraw_event e) noexcept override;
     void on_event(keyboard_event e) noexcept override;
     void on_event(mouse_event e) noexcept override;
 
+  private:
+    template <class E> details::handler_list<E> &handlers() noexcept {
+        return std::get<details::handler_list<E>>(m_handlers);
+    }
+
+    void update_size(resize_event e) noexcept;
+    void deliver(resize_event e) noexcept;
+    void deliver(redraw_event e) noexcept;
+    void deliver(keyboard_event e) noexcept;
+    void deliver(mouse_event e) noexcept;
+
   private:
     std::unique_ptr<window_client> m_client;
-    std::list<std::unique_ptr<window_watcher>> m_watchers;
+    std::unique_ptr<event_queue> m_queue;
+    details::handler_lists<any_event>::type m_handlers;
     window_attrs m_attrs{};
     window_size m_normal_size{};
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+///
+/// A GL context for another thread, sharing buffers, textures, programs,
+/// samplers and sync objects with every window's context (containers such
+/// as VAOs and FBOs are never shared). Meant for uploading resources off
+/// the render thread.
+///
+/// It must be created and destroyed on the thread handling the windows,
+/// but may be current on any one thread at a time: `make_current` there,
+/// then `release` before another thread takes it (or before destroying).
+class worker_context {
+  public:
+    worker_context() = default;
+    explicit worker_context(std::unique_ptr<worker_context_client> client)
+        : m_client{std::move(client)} {}
+
+    explicit operator bool() const noexcept { return m_client != nullptr; }
+
+    void make_current() noexcept {
+        if (m_client) {
+            m_client->make_current();
+        }
+    }
+
+    /// Makes no context current on the calling thread.
+    void release() noexcept {
+        if (m_client) {
+            m_client->release();
+        }
+    }
+
+  private:
+    std::unique_ptr<worker_context_client> m_client;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
 class window_system {
   public:
     window make_window(window_attrs attrs = {});
 
     void poll_events();
 
+    /// Like `poll_events`, but first sleeps until an event arrives, `wake`
+    /// is called or `deadline` passes; time_point::max() has no deadline.
+    /// Doesn't sleep while injected events are pending, nor without a
+    /// platform client (nothing could come to end the wait).
+    void wait_events_until(std::chrono::steady_clock::time_point deadline);
+
+    /// Ends a `wait_events_until` in progress. Callable from any thread.
+    void wake() noexcept;
+
     gl_context make_gl_context() const noexcept;
     void make_current(window &wnd);
 
+    /// All windows' contexts share objects, so resources created while one
+    /// is current can be used with any other; a worker context shares them
+    /// too. Empty if there is no platform client or creation failed.
+    worker_context make_worker_context();
+
+    /// Queues a synthetic event for `wnd`, delivered to its handlers by the
+    /// next `poll_events` (after the platform's events, in injection order).
+    /// `wnd` must stay alive and in place until then. Input events without
+    /// a `time` are stamped with the current one.
+    void inject(window &wnd, any_event e);
+
   public:
     void set_client(std::unique_ptr<window_system_client>);
 
+  private:
+    void deliver_injected();
+
   private:
     std::unique_ptr<window_system_client> m_client;
+    std::vector<std::pair<window *, any_event>> m_injected;
+    std::vector<std::pair<window *, any_event>> m_delivering;
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
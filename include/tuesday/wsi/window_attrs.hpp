@@ -12,6 +12,21 @@ enum class window_mode : std::uint8_t {
     fullscreen,
 };
 
+/// `captured` hides the cursor and keeps it in the window, reporting
+/// unbounded, unaccelerated ("raw") motion where the platform supports it;
+/// for camera controls rather than pointing.
+enum class cursor_mode : std::uint8_t {
+    normal,
+    captured,
+};
+
+/// Vertical blanks to wait for before a buffer swap shows: 0 swaps at once
+/// (lowest latency, may tear), 1 is vsync, -1 adaptive vsync (waits unless
+/// the frame is already late, then swaps at once; 1 where unsupported).
+struct swap_interval {
+    int frames{1};
+};
+
 ///
 struct window_pos {
     int x{};
@@ -29,10 +44,14 @@ struct window_attrs {
     window_pos pos{};
     window_size size{};
     window_mode mode{window_mode::normal};
+    cursor_mode cursor{cursor_mode::normal};
+    swap_interval swap{};
 
     void set(window_pos val) { pos = val; }
     void set(window_size val) { size = val; }
     void set(window_mode val) { mode = val; }
+    void set(cursor_mode val) { cursor = val; }
+    void set(swap_interval val) { swap = val; }
 
     template <class Attr> window_attrs &with(Attr &&val) {
         set(std::forward<Attr>(val));
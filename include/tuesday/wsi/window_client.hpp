@@ -4,6 +4,7 @@
 #include <tuesday/wsi/window_attrs.hpp>
 #include <tuesday/wsi/window_events.hpp>
 
+#include <chrono>
 #include <memory>
 
 namespace tue::wsi {
@@ -17,6 +18,8 @@ class window_context {
     virtual window_pos get_normal_pos() const noexcept = 0;
     virtual window_size get_normal_size() const noexcept = 0;
     virtual window_mode get_default_mode() const noexcept = 0;
+    virtual cursor_mode get_cursor_mode() const noexcept = 0;
+    virtual swap_interval get_swap_interval() const noexcept = 0;
 
     virtual void on_event(resize_event) = 0;
     virtual void on_event(redraw_event) = 0;
@@ -47,6 +50,15 @@ class window_client {
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+/// A GL context without a window, sharing objects with the windows'.
+class worker_context_client {
+  public:
+    virtual ~worker_context_client() = default;
+
+    virtual void make_current() noexcept = 0;
+    virtual void release() noexcept = 0;
+};
+
 struct gl_context {
     using proc_fn = void (*)();
     using proc_addr_fn = proc_fn (*)(const char *);
@@ -62,8 +74,17 @@ class window_system_client {
 
     virtual void poll_events() = 0;
 
+    /// Processes the pending events, first blocking up to `timeout` for
+    /// one to arrive or for `wake`; nanoseconds::max() blocks until then.
+    virtual void wait_events_for(std::chrono::nanoseconds timeout) = 0;
+
+    /// Ends a `wait_events_for` in progress. Callable from any thread.
+    virtual void wake() noexcept = 0;
+
     virtual gl_context make_gl_context() const noexcept = 0;
     virtual void make_current(window_client &wc) noexcept = 0;
+
+    virtual std::unique_ptr<worker_context_client> make_worker_context() = 0;
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
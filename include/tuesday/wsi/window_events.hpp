@@ -4,8 +4,15 @@
 #include <tuesday/wsi/keyboard.hpp>
 #include <tuesday/wsi/window_attrs.hpp>
 
+#include <chrono>
+#include <variant>
+
 namespace tue::wsi {
 
+/// When the platform reported an event, on the clock used for frame timing;
+/// left zero for synthetic events until window_system::inject stamps them.
+using event_time = std::chrono::steady_clock::time_point;
+
 ///
 struct resize_event {
     window_size size{};
@@ -20,6 +27,7 @@ struct keyboard_event {
     key_code code{key_code::unspec};
     key_action act{key_action::unspec};
     key_mods mods{key_mods::unspec};
+    event_time time{};
 
     constexpr bool pressed(key_code c) const noexcept {
         return act == key_action::pressed && code == c;
@@ -30,6 +38,8 @@ struct keyboard_event {
     }
 };
 
+/// `pos` is the cursor position (any value while the cursor is captured,
+/// see cursor_mode) and `delta` the motion since the previous event.
 struct mouse_event {
     key_code code{key_code::unspec};
     key_action act{key_action::unspec};
@@ -39,6 +49,8 @@ struct mouse_event {
         double x{};
         double y{};
     } pos{};
+    position delta{};
+    event_time time{};
 
     constexpr bool pressed(key_code c) const noexcept {
         return act == key_action::pressed && code == c;
@@ -53,6 +65,10 @@ struct mouse_event {
     }
 };
 
+///
+using any_event =
+    std::variant<resize_event, redraw_event, keyboard_event, mouse_event>;
+
 } // namespace tue::wsi
 
 #endif
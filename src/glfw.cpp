@@ -1,6 +1,5 @@
 #include "glfw.hpp"
 
-#include <map>
 #include <print>
 
 namespace glfw {
@@ -33,6 +32,7 @@ void window_client::swap(window_client &other) noexcept {
     if (this != &other) {
         m_wndsys = std::exchange(other.m_wndsys, nullptr);
         m_handle = std::exchange(other.m_handle, nullptr);
+        m_cursor = std::exchange(other.m_cursor, {});
         assign_handle_client(m_handle, this);
         assign_handle_client(other.m_handle, &other);
     }
@@ -62,6 +62,9 @@ void window_client::reload_attrs() {
     }
 
     if (auto *ctx = context()) {
+        reload_cursor();
+        reload_swap_interval();
+
         auto mode = ctx->get_default_mode();
         GLFWmonitor *mon = glfwGetWindowMonitor(m_handle);
         if (mode == tue::wsi::window_mode::fullscreen) {
@@ -82,6 +85,42 @@ void window_client::reload_attrs() {
     }
 }
 
+void window_client::reload_cursor() {
+    const auto *ctx = context();
+    if (m_handle == nullptr || ctx == nullptr) {
+        return;
+    }
+
+    const bool captured =
+        ctx->get_cursor_mode() == tue::wsi::cursor_mode::captured;
+    glfwSetInputMode(m_handle, GLFW_CURSOR,
+                     captured ? GLFW_CURSOR_DISABLED : GLFW_CURSOR_NORMAL);
+    if (glfwRawMouseMotionSupported() == GLFW_TRUE) {
+        glfwSetInputMode(m_handle, GLFW_RAW_MOUSE_MOTION,
+                         captured ? GLFW_TRUE : GLFW_FALSE);
+    }
+
+    // the position jumps when the cursor is captured or released: no delta
+    glfwGetCursorPos(m_handle, &m_cursor.x, &m_cursor.y);
+}
+
+void window_client::reload_swap_interval() {
+    const auto *ctx = context();
+    // applies to the current context only: done again by make_current
+    if (ctx == nullptr || m_handle == nullptr ||
+        glfwGetCurrentContext() != m_handle) {
+        return;
+    }
+
+    int frames = ctx->get_swap_interval().frames;
+    if (frames < 0 &&
+        glfwExtensionSupported("WGL_EXT_swap_control_tear") == GLFW_FALSE &&
+        glfwExtensionSupported("GLX_EXT_swap_control_tear") == GLFW_FALSE) {
+        frames = 1;
+    }
+    glfwSwapInterval(frames);
+}
+
 void window_client::redraw() {
     if (m_handle != nullptr) {
         glfwSwapBuffers(m_handle);
@@ -94,30 +133,21 @@ bool window_client::should_close() const {
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-using client_map_t = std::map<GLFWwindow *, window_client *>;
-
-static client_map_t &client_map() noexcept {
-    static std::map<GLFWwindow *, window_client *> map;
-    return map;
-}
+// the client is stored in the window's user pointer: one load per callback,
+// whatever the number of windows
 
 static void assign_handle_client(GLFWwindow *h, window_client *c) noexcept {
-    if (h == nullptr) {
-        return;
+    if (h != nullptr) {
+        glfwSetWindowUserPointer(h, c);
     }
-
-    auto &map = client_map();
-    auto iter = map.find(h);
-    map.insert_or_assign(iter, h, c);
 }
 
 static void erase_handle_client(GLFWwindow *h) noexcept {
-    client_map().erase(h);
+    assign_handle_client(h, nullptr);
 }
 
 static window_client *find_client(GLFWwindow *h) noexcept {
-    auto iter = client_map().find(h);
-    return iter == client_map().end() ? nullptr : iter->second;
+    return static_cast<window_client *>(glfwGetWindowUserPointer(h));
 }
 
 static tue::wsi::window_context *find_client_context(GLFWwindow *h) noexcept {
@@ -138,15 +168,84 @@ static void cb_cursor(GLFWwindow *h, double x, double y);
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-window_system_client::window_system_client() {
+window_system_client::window_system_client(bool headless)
+    : m_headless{headless} {
     glfwSetErrorCallback(cb_error);
+    if (m_headless) {
+        // no display connection; windows exist only as GL surfaces
+        glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+    }
     glfwInit();
 }
 
 window_system_client::~window_system_client() {
+    if (m_root != nullptr) {
+        glfwDestroyWindow(m_root);
+    }
     glfwTerminate();
 }
 
+GLFWwindow *window_system_client::create_native(tue::wsi::window_size size,
+                                                GLFWmonitor *mon,
+                                                GLFWwindow *share) {
+    if (!m_headless) {
+        return glfwCreateWindow(size.width, size.height, "", mon, share);
+    }
+
+    // Mesa's surfaceless EGL (GPU or llvmpipe), else software OSMesa; once
+    // one works, stick to it: contexts of different APIs can't share
+    for (int api : {GLFW_EGL_CONTEXT_API, GLFW_OSMESA_CONTEXT_API}) {
+        if (m_context_api != 0 && api != m_context_api) {
+            continue;
+        }
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, api);
+        GLFWwindow *h =
+            glfwCreateWindow(size.width, size.height, "", nullptr, share);
+        if (h != nullptr) {
+            m_context_api = api;
+            return h;
+        }
+    }
+    return nullptr;
+}
+
+// objects are shared between all contexts in a share group: a hidden root
+// context joins them, whichever windows come and go
+
+GLFWwindow *window_system_client::share_root() {
+    if (m_root == nullptr) {
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        m_root = create_native({1, 1}, nullptr, nullptr);
+    }
+    return m_root;
+}
+
+std::unique_ptr<tue::wsi::worker_context_client>
+window_system_client::make_worker_context() {
+    GLFWwindow *root = share_root();
+    if (root == nullptr) {
+        return nullptr;
+    }
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    GLFWwindow *h = create_native({1, 1}, nullptr, root);
+    if (h == nullptr) {
+        return nullptr;
+    }
+    return std::make_unique<worker_context_client>(h);
+}
+
+void window_system_client::wait_events_for(std::chrono::nanoseconds timeout) {
+    if (timeout == std::chrono::nanoseconds::max()) {
+        glfwWaitEvents();
+    }
+    else if (timeout > std::chrono::nanoseconds::zero()) {
+        glfwWaitEventsTimeout(std::chrono::duration<double>(timeout).count());
+    }
+    else {
+        glfwPollEvents();
+    }
+}
+
 void window_system_client::create_handle(window_client &wc) {
     auto *ctx = wc.context();
 
@@ -155,14 +254,14 @@ void window_system_client::create_handle(window_client &wc) {
     auto mode = (ctx != nullptr) ? ctx->get_default_mode()
                                  : tue::wsi::window_mode::normal;
 
-    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
-
     GLFWmonitor *mon = nullptr;
     if (mode == tue::wsi::window_mode::fullscreen) {
         mon = glfwGetPrimaryMonitor();
     }
 
-    GLFWwindow *h = glfwCreateWindow(size.width, size.height, "", mon, nullptr);
+    GLFWwindow *root = share_root();
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    GLFWwindow *h = create_native(size, mon, root);
     if (h == nullptr) {
         return;
     }
@@ -178,13 +277,25 @@ void window_system_client::create_handle(window_client &wc) {
     }
 
     assign_handle_client(h, &wc);
+    wc.reload_cursor();
 
     glfwShowWindow(h);
 }
 void window_system_client::destroy_handle(window_client &wc) {
     if (GLFWwindow *old = wc.set_native_handle(nullptr)) {
-        glfwDestroyWindow(old);
         erase_handle_client(old);
+        glfwDestroyWindow(old);
+    }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+worker_context_client::~worker_context_client() {
+    if (m_handle != nullptr) {
+        if (glfwGetCurrentContext() == m_handle) {
+            glfwMakeContextCurrent(nullptr);
+        }
+        glfwDestroyWindow(m_handle);
     }
 }
 
@@ -206,33 +317,47 @@ static void cb_fbsize(GLFWwindow *h, int width, int height) {
     }
 }
 
+// input events are stamped first thing, before any other work
+
 static void cb_key(GLFWwindow *h, int key, [[maybe_unused]] int scancode,
                    int action, int mods) {
+    const auto t = tue::wsi::event_time::clock::now();
     if (auto *ctx = find_client_context(h)) {
         ctx->on_event(tue::wsi::keyboard_event{
             .code = key_code_from_glfw(key),
             .act = key_action_from_glfw(action),
             .mods = key_mods_from_glfw(mods),
+            .time = t,
         });
     }
 }
 
 static void cb_mouse(GLFWwindow *h, int key, int action, int mods) {
-    if (auto *ctx = find_client_context(h)) {
-        tue::wsi::mouse_event::position pos{};
-        glfwGetCursorPos(h, &pos.x, &pos.y);
+    const auto t = tue::wsi::event_time::clock::now();
+    auto *cli = find_client(h);
+    if (auto *ctx = (cli != nullptr) ? cli->context() : nullptr) {
         ctx->on_event(tue::wsi::mouse_event{
             .code = key_code_from_glfw(key),
             .act = key_action_from_glfw(action),
             .mods = key_mods_from_glfw(mods),
-            .pos = pos,
+            .pos = cli->cursor_pos(),
+            .time = t,
         });
     }
 }
 
 static void cb_cursor(GLFWwindow *h, double x, double y) {
-    if (auto *ctx = find_client_context(h)) {
-        ctx->on_event(tue::wsi::mouse_event{.pos = {x, y}});
+    const auto t = tue::wsi::event_time::clock::now();
+    if (auto *cli = find_client(h)) {
+        // raw (unaccelerated) motion when the cursor is captured
+        const auto delta = cli->move_cursor(x, y);
+        if (auto *ctx = cli->context()) {
+            ctx->on_event(tue::wsi::mouse_event{
+                .pos = {x, y},
+                .delta = delta,
+                .time = t,
+            });
+        }
     }
 }
 
@@ -295,8 +420,8 @@ static tue::wsi::key_mods key_mods_from_glfw(int mods) noexcept {
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-std::unique_ptr<window_system_client> make_window_system_client() {
-    return std::make_unique<window_system_client>();
+std::unique_ptr<window_system_client> make_window_system_client(bool headless) {
+    return std::make_unique<window_system_client>(headless);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
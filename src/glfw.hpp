@@ -31,6 +31,19 @@ class window_client : public tue::wsi::window_client {
     void reload_attrs() override;
     void redraw() override;
 
+  public:
+    /// Cursor position as of the last cursor callback (no query needed).
+    tue::wsi::mouse_event::position cursor_pos() const noexcept {
+        return m_cursor;
+    }
+
+    /// Records a new cursor position; returns the motion since the last.
+    tue::wsi::mouse_event::position move_cursor(double x, double y) noexcept {
+        const tue::wsi::mouse_event::position d{x - m_cursor.x, y - m_cursor.y};
+        m_cursor = {x, y};
+        return d;
+    }
+
   protected:
     friend class window_system_client;
 
@@ -40,16 +53,38 @@ class window_client : public tue::wsi::window_client {
         return std::exchange(m_handle, handle);
     }
 
+    void reload_cursor();
+    void reload_swap_interval();
+
   private:
     window_system_client *m_wndsys{nullptr};
     GLFWwindow *m_handle{nullptr};
+    tue::wsi::mouse_event::position m_cursor{};
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+class worker_context_client : public tue::wsi::worker_context_client {
+  public:
+    explicit worker_context_client(GLFWwindow *handle) noexcept
+        : m_handle{handle} {}
+    ~worker_context_client();
+
+    worker_context_client(const worker_context_client &) = delete;
+    worker_context_client &operator=(const worker_context_client &) = delete;
+
+    void make_current() noexcept override { glfwMakeContextCurrent(m_handle); }
+    void release() noexcept override { glfwMakeContextCurrent(nullptr); }
+
+  private:
+    GLFWwindow *m_handle{nullptr}; // hidden, never shown
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 class window_system_client : public tue::wsi::window_system_client {
   public:
-    window_system_client();
+    explicit window_system_client(bool headless = false);
     ~window_system_client();
 
     std::unique_ptr<tue::wsi::window_client> make_window_client() override {
@@ -57,27 +92,44 @@ class window_system_client : public tue::wsi::window_system_client {
     }
 
     void poll_events() override { glfwPollEvents(); }
+    void wait_events_for(std::chrono::nanoseconds timeout) override;
+    void wake() noexcept override { glfwPostEmptyEvent(); }
 
     tue::wsi::gl_context make_gl_context() const noexcept override {
         return {.proc_addr = glfwGetProcAddress};
     }
 
     void make_current(tue::wsi::window_client &wc) noexcept override {
-        auto *h = static_cast<window_client &>(wc).get_native_handle();
-        if (h != nullptr) {
+        auto &c = static_cast<window_client &>(wc);
+        if (auto *h = c.get_native_handle()) {
             glfwMakeContextCurrent(h);
+            c.reload_swap_interval();
         }
     }
 
+    std::unique_ptr<tue::wsi::worker_context_client>
+    make_worker_context() override;
+
   protected:
     friend class window_client;
     void create_handle(window_client &wc);
     void destroy_handle(window_client &wc);
+
+  private:
+    GLFWwindow *create_native(tue::wsi::window_size size, GLFWmonitor *mon,
+                              GLFWwindow *share);
+    GLFWwindow *share_root();
+
+  private:
+    bool m_headless{false};
+    int m_context_api{0}; // headless: the one that worked first
+    GLFWwindow *m_root{nullptr}; // hidden; every context shares with it
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-std::unique_ptr<window_system_client> make_window_system_client();
+std::unique_ptr<window_system_client>
+make_window_system_client(bool headless = false);
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
@@ -0,0 +1,169 @@
+#include <tuesday/gfx/gpu_profiler.hpp>
+
+#include <tuesday/assert.hpp>
+
+#include <algorithm>
+#include <print>
+
+namespace tue::gfx {
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+gpu_profiler::gpu_profiler(std::size_t frames_in_flight)
+    : m_sets(frames_in_flight < 2 ? 2 : frames_in_flight) {}
+
+gpu_profiler::~gpu_profiler() {
+    for (auto &set : m_sets) {
+        if (!set.queries.empty()) {
+            glDeleteQueries(static_cast<GLsizei>(set.queries.size()),
+                            set.queries.data());
+        }
+    }
+}
+
+bool gpu_profiler::begin_frame() {
+    if (!m_checked) {
+        m_checked = true;
+        m_supported = GLAD_GL_VERSION_3_3 != 0;
+#if defined(GL_ARB_timer_query)
+        m_supported = m_supported || GLAD_GL_ARB_timer_query != 0;
+#endif
+        if (!m_supported) {
+            std::println(stderr, "[gfx] timer queries are not supported");
+        }
+    }
+    if (!m_supported) {
+        return false;
+    }
+
+    tue_assert(!m_recording, "end_frame was not called");
+
+    // sets complete in submission order: oldest first, newest wins
+    bool fresh{false};
+    const auto n = m_sets.size();
+    for (std::size_t k{1}; k <= n; ++k) {
+        auto &set = m_sets[(m_current + k) % n];
+        if (set.pending && available(set)) {
+            read_back(set);
+            set.pending = false;
+            fresh = true;
+        }
+    }
+
+    m_current = (m_current + 1) % n;
+    auto &set = m_sets[m_current];
+    if (set.pending) {
+        m_dropped += 1;
+        set.pending = false;
+    }
+
+    set.used = 0;
+    set.markers.clear();
+    m_open.clear();
+
+    reserve(set, 2);
+    set.markers.push_back(marker{.name = "frame", .begin = timestamp(set)});
+    m_recording = true;
+    return fresh;
+}
+
+void gpu_profiler::end_frame() noexcept {
+    if (!m_recording) {
+        return;
+    }
+
+    tue_assert(m_open.empty(), "unbalanced gpu profiler scopes");
+    while (!m_open.empty()) {
+        end();
+    }
+
+    auto &set = m_sets[m_current];
+    set.markers.front().end = timestamp(set);
+    set.pending = true;
+    m_recording = false;
+}
+
+void gpu_profiler::begin(std::string_view name) {
+    if (!m_recording) {
+        return;
+    }
+
+    // this scope's begin and end, on top of the ends of those still open
+    auto &set = m_sets[m_current];
+    reserve(set, m_open.size() + 3);
+    m_open.push_back(static_cast<std::uint32_t>(set.markers.size()));
+    set.markers.push_back(marker{
+        .name = name,
+        .depth = static_cast<std::uint32_t>(m_open.size() - 1),
+        .begin = timestamp(set),
+    });
+}
+
+void gpu_profiler::end() noexcept {
+    if (!m_recording || m_open.empty()) {
+        return;
+    }
+
+    auto &set = m_sets[m_current];
+    set.markers[m_open.back()].end = timestamp(set);
+    m_open.pop_back();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void gpu_profiler::reserve(frame_set &set, std::size_t n) {
+    const auto size = set.queries.size();
+    if (set.used + n <= size) {
+        return;
+    }
+
+    // grow the pool: a steady frame stops allocating after warm-up
+    const auto more = std::max(set.used + n - size, size == 0 ? 16 : size);
+    set.queries.resize(size + more);
+    glGenQueries(static_cast<GLsizei>(more), set.queries.data() + size);
+}
+
+std::uint32_t gpu_profiler::timestamp(frame_set &set) noexcept {
+    tue_assert(set.used < set.queries.size(), "queries were not reserved");
+
+    const auto index = set.used++;
+    glQueryCounter(set.queries[index], GL_TIMESTAMP);
+    return static_cast<std::uint32_t>(index);
+}
+
+bool gpu_profiler::available(const frame_set &set) const noexcept {
+    if (set.used == 0) {
+        return false;
+    }
+    // queries finish in order: the last one being ready means all are
+    return query_available(set.queries[set.used - 1]);
+}
+
+void gpu_profiler::read_back(frame_set &set) {
+    m_times.resize(set.used);
+    for (std::size_t i{0}; i < set.used; ++i) {
+        m_times[i] = query_result(set.queries[i]);
+    }
+
+    const auto ms = [this](std::uint32_t from, std::uint32_t to) {
+        return static_cast<double>(m_times[to] - m_times[from]) * 1e-6;
+    };
+
+    const auto &frame = set.markers.front();
+    m_frame_ms = ms(frame.begin, frame.end);
+
+    m_results.clear();
+    for (std::size_t i{1}; i < set.markers.size(); ++i) {
+        const auto &m = set.markers[i];
+        m_results.push_back(gpu_scope_result{
+            .name = m.name,
+            .depth = m.depth,
+            .start_ms = ms(frame.begin, m.begin),
+            .ms = ms(m.begin, m.end),
+        });
+    }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+} // namespace tue::gfx
@@ -0,0 +1,106 @@
+#include <tuesday/gfx/mesh_batch.hpp>
+#include <tuesday/profile.hpp>
+
+#include <cstdint>
+
+namespace tue::gfx {
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+indirect_commands::~indirect_commands() {
+    if (m_buffer != 0) {
+        glDeleteBuffers(1, &m_buffer);
+    }
+}
+
+void indirect_commands::push(mesh_range m, GLuint instance_count,
+                             GLuint base_instance) {
+    if (m.indexed()) {
+        m_elems.push_back(draw_elements_indirect_command{
+            .count = m.index_count,
+            .instance_count = instance_count,
+            .first_index = m.first_index,
+            .base_vertex = static_cast<GLint>(m.first_vertex),
+            .base_instance = base_instance,
+        });
+    }
+    else {
+        m_arrays.push_back(draw_arrays_indirect_command{
+            .count = m.vertex_count,
+            .instance_count = instance_count,
+            .first = m.first_vertex,
+            .base_instance = base_instance,
+        });
+    }
+}
+
+void indirect_commands::upload() {
+    const auto arrays_size = static_cast<GLsizeiptr>(elements_offset());
+    const auto elems_size = static_cast<GLsizeiptr>(
+        m_elems.size() * sizeof(draw_elements_indirect_command));
+    const auto total = arrays_size + elems_size;
+
+    m_num_arrays = static_cast<GLsizei>(m_arrays.size());
+    m_num_elems = static_cast<GLsizei>(m_elems.size());
+    m_elems_offset = arrays_size;
+
+    if (total == 0) {
+        return;
+    }
+
+    if (m_buffer == 0) {
+        glCreateBuffers(1, &m_buffer);
+        tue_assert(m_buffer != 0);
+    }
+
+    if (total > m_capacity) {
+        m_capacity = total + total / 2;
+    }
+    // orphan the previous storage, the GPU may still read last frame's
+    glNamedBufferData(m_buffer, m_capacity, nullptr, GL_STREAM_DRAW);
+
+    if (arrays_size > 0) {
+        glNamedBufferSubData(m_buffer, 0, arrays_size, m_arrays.data());
+    }
+    if (elems_size > 0) {
+        glNamedBufferSubData(m_buffer, arrays_size, elems_size,
+                             m_elems.data());
+    }
+}
+
+void indirect_commands::draw(state_cache &state, vertex_array vao,
+                             GLenum mode, GLenum index_type) const {
+    tue_profile_scope("gfx.indirect_commands.draw");
+    if (m_num_arrays + m_num_elems == 0) {
+        return;
+    }
+
+    state.bind_vertex_array(vao);
+    state.bind_buffer(GL_DRAW_INDIRECT_BUFFER, m_buffer);
+
+    if (m_num_arrays > 0) {
+        glMultiDrawArraysIndirect(mode, nullptr, m_num_arrays, 0);
+    }
+    if (m_num_elems > 0) {
+        const auto offset = static_cast<std::uintptr_t>(m_elems_offset);
+        glMultiDrawElementsIndirect(mode, index_type,
+                                    reinterpret_cast<const void *>(offset),
+                                    m_num_elems, 0);
+    }
+}
+
+void indirect_commands::release(state_cache &state) noexcept {
+    if (m_buffer != 0) {
+        state.forget_buffer(m_buffer);
+        glDeleteBuffers(1, &m_buffer);
+        m_buffer = 0;
+    }
+    m_capacity = 0;
+    m_num_arrays = 0;
+    m_num_elems = 0;
+    m_elems_offset = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+} // namespace tue::gfx
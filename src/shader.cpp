@@ -1,17 +1,24 @@
 #include <tuesday/gfx/shader.hpp>
 
+#include <algorithm>
+#include <print>
+
 namespace tue::gfx {
 
 shader_stage make_shader_stage(std::string_view src, GLenum type) noexcept {
     GLuint id = glCreateShader(type);
 
     const GLchar *ptr = (GLchar *)src.data();
-    glShaderSource(id, 1, &ptr, nullptr);
+    const auto len = static_cast<GLint>(src.size());
+    glShaderSource(id, 1, &ptr, &len);
     glCompileShader(id);
 
     GLint status = 0;
     glGetShaderiv(id, GL_COMPILE_STATUS, &status);
     if (status == 0) {
+        std::println(stderr, "[gfx] shader compilation failed: {}",
+                     info_log(shader_stage{id, type}));
+        glDeleteShader(id);
         return {};
     }
 
@@ -23,30 +30,46 @@ void delete_shader_stage(shader_stage &s) noexcept {
     s = {};
 }
 
-shader_program link_shader(std::span<shader_stage> stages) noexcept {
+shader_program link_shader(std::span<shader_stage> stages,
+                           link_options opts) noexcept {
     GLint status{0};
 
     GLuint id = glCreateProgram();
+    if (opts.binary_retrievable) {
+        glProgramParameteri(id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
     for (auto &stage : stages) {
         glAttachShader(id, stage.id);
     }
     glLinkProgram(id);
 
+    for (auto &stage : stages) {
+        glDetachShader(id, stage.id);
+    }
+
     glGetProgramiv(id, GL_LINK_STATUS, &status);
     if (status == 0) {
+        std::println(stderr, "[gfx] shader linking failed: {}",
+                     info_log(shader_program{id}));
+        glDeleteProgram(id);
         return {};
     }
 
     return shader_program{.id = id};
 }
 
-shader_program make_shader(std::string_view vs_src,
-                           std::string_view fs_src) noexcept {
+shader_program make_shader(std::string_view vs_src, std::string_view fs_src,
+                           link_options opts) noexcept {
     shader_stage stages[] = {
         make_shader_stage(vs_src, GL_VERTEX_SHADER),
         make_shader_stage(fs_src, GL_FRAGMENT_SHADER),
     };
-    auto sp = link_shader(std::span{stages, 2});
+
+    shader_program sp{};
+    if (stages[0] && stages[1]) {
+        sp = link_shader(std::span{stages, 2}, opts);
+    }
+
     for (auto &ss : stages) {
         delete_shader_stage(ss);
     }
@@ -60,8 +83,82 @@ void delete_shader(shader_program &s) noexcept {
     s = {};
 }
 
+std::string info_log(shader_stage s) {
+    GLint len = 0;
+    glGetShaderiv(s.id, GL_INFO_LOG_LENGTH, &len);
+    std::string log(len > 0 ? len : 0, '\0');
+    if (len > 0) {
+        glGetShaderInfoLog(s.id, len, nullptr, log.data());
+    }
+    return log;
+}
+
+std::string info_log(shader_program p) {
+    GLint len = 0;
+    glGetProgramiv(p.id, GL_INFO_LOG_LENGTH, &len);
+    std::string log(len > 0 ? len : 0, '\0');
+    if (len > 0) {
+        glGetProgramInfoLog(p.id, len, nullptr, log.data());
+    }
+    return log;
+}
+
 GLint find_uniform(shader_program p, std::string_view name) noexcept {
     return glGetUniformLocation(p.id, name.data());
 }
 
+const uniform_info *uniform_table::find(uniform_key key) const noexcept {
+    auto it = std::ranges::lower_bound(entries, key, {}, &uniform_info::key);
+    return (it != entries.end() && it->key == key) ? &*it : nullptr;
+}
+
+uniform_table reflect_uniforms(shader_program p) {
+    uniform_table table;
+    if (!p) {
+        return table;
+    }
+
+    GLint num_uniforms = 0;
+    glGetProgramInterfaceiv(p.id, GL_UNIFORM, GL_ACTIVE_RESOURCES,
+                            &num_uniforms);
+    GLint max_name = 0;
+    glGetProgramInterfaceiv(p.id, GL_UNIFORM, GL_MAX_NAME_LENGTH, &max_name);
+
+    table.entries.reserve(num_uniforms);
+    std::string name(max_name > 0 ? max_name : 0, '\0');
+
+    constexpr GLenum props[] = {GL_LOCATION, GL_TYPE, GL_ARRAY_SIZE};
+    for (GLint i{0}; i < num_uniforms; ++i) {
+        GLint values[std::size(props)]{};
+        glGetProgramResourceiv(p.id, GL_UNIFORM, i, std::size(props), props,
+                               std::size(values), nullptr, values);
+        if (values[0] < 0) {
+            continue; // a member of a uniform block
+        }
+
+        GLsizei len = 0;
+        glGetProgramResourceName(p.id, GL_UNIFORM, i, max_name, &len,
+                                 name.data());
+        std::string_view sv{name.data(), static_cast<std::size_t>(len)};
+        if (sv.ends_with("[0]")) {
+            sv.remove_suffix(3); // arrays are reported as "name[0]"
+        }
+
+        table.entries.push_back(uniform_info{
+            .key = make_uniform_key(sv),
+            .location = values[0],
+            .type = static_cast<GLenum>(values[1]),
+            .count = values[2],
+        });
+    }
+
+    std::ranges::sort(table.entries, {}, &uniform_info::key);
+    tue_assert(std::ranges::adjacent_find(table.entries, {},
+                                          &uniform_info::key) ==
+                   table.entries.end(),
+               "uniform name hash collision");
+
+    return table;
+}
+
 } // namespace tue::gfx
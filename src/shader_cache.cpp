@@ -0,0 +1,216 @@
+#include <tuesday/gfx/shader_cache.hpp>
+
+#include <fstream>
+#include <format>
+#include <print>
+#include <system_error>
+#include <vector>
+
+namespace tue::gfx {
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+namespace {
+
+constexpr std::uint64_t fnv_offset = 0xcbf29ce484222325ULL;
+constexpr std::uint64_t fnv_prime = 0x100000001b3ULL;
+
+constexpr std::uint64_t fnv1a(std::uint64_t h, const void *data,
+                              std::size_t size) noexcept {
+    const auto *p = static_cast<const unsigned char *>(data);
+    for (std::size_t i{0}; i < size; ++i) {
+        h = (h ^ p[i]) * fnv_prime;
+    }
+    return h;
+}
+
+/// Hashes the length too, so that {"ab", "c"} and {"a", "bc"} differ.
+constexpr std::uint64_t fnv1a(std::uint64_t h, std::string_view s) noexcept {
+    const std::uint64_t len = s.size();
+    h = fnv1a(h, &len, sizeof(len));
+    return fnv1a(h, s.data(), s.size());
+}
+
+std::string_view gl_string(GLenum name) noexcept {
+    const auto *s = reinterpret_cast<const char *>(glGetString(name));
+    return s != nullptr ? std::string_view{s} : std::string_view{};
+}
+
+struct entry_header {
+    static constexpr std::uint32_t magic_value = 0x50455554; // "TUEP"
+    static constexpr std::uint32_t version_value = 1;
+    // far above any real program binary; longer ones are corrupt
+    static constexpr std::uint32_t max_length = 64U << 20;
+
+    std::uint32_t magic{magic_value};
+    std::uint32_t version{version_value};
+    std::uint64_t key{0};
+    std::uint32_t format{0};
+    std::uint32_t length{0};
+};
+
+} // namespace
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+shader_cache::shader_cache(std::filesystem::path dir) : m_dir{std::move(dir)} {
+    GLint num_formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &num_formats);
+    if (num_formats <= 0) {
+        return;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(m_dir, ec);
+    if (ec) {
+        std::println(stderr, "[gfx] shader cache disabled: {}", ec.message());
+        return;
+    }
+
+    auto h = fnv_offset;
+    h = fnv1a(h, gl_string(GL_VENDOR));
+    h = fnv1a(h, gl_string(GL_RENDERER));
+    h = fnv1a(h, gl_string(GL_VERSION));
+    h = fnv1a(h, gl_string(GL_SHADING_LANGUAGE_VERSION));
+    m_context_hash = h;
+    m_enabled = true;
+}
+
+shader_cache_key shader_cache::make_key(
+    std::initializer_list<std::string_view> sources) const noexcept {
+    auto h = fnv1a(fnv_offset, &m_context_hash, sizeof(m_context_hash));
+    for (auto src : sources) {
+        h = fnv1a(h, src);
+    }
+    return shader_cache_key{h != 0 ? h : 1};
+}
+
+std::filesystem::path shader_cache::entry_path(shader_cache_key key) const {
+    return m_dir / std::format("{:016x}.bin", key.hash);
+}
+
+shader_program shader_cache::load(shader_cache_key key) noexcept {
+    if (!m_enabled || !key) {
+        return {};
+    }
+
+    const auto path = entry_path(key);
+    std::error_code ec;
+    const auto size = std::filesystem::file_size(path, ec);
+    std::ifstream in{path, std::ios::binary};
+    if (ec || !in) {
+        m_stats.misses += 1;
+        return {};
+    }
+
+    // a corrupt or truncated entry is dropped, like one the driver rejects
+    const auto drop = [&] {
+        in.close();
+        std::filesystem::remove(path, ec);
+        m_stats.misses += 1;
+        return shader_program{};
+    };
+
+    entry_header hdr{};
+    in.read(reinterpret_cast<char *>(&hdr), sizeof(hdr));
+    if (!in || hdr.magic != entry_header::magic_value ||
+        hdr.version != entry_header::version_value || hdr.key != key.hash) {
+        return drop();
+    }
+    if (hdr.length == 0 || hdr.length > entry_header::max_length ||
+        sizeof(hdr) + hdr.length > size) {
+        return drop();
+    }
+
+    std::vector<char> blob(hdr.length);
+    in.read(blob.data(), static_cast<std::streamsize>(blob.size()));
+    if (!in) {
+        return drop();
+    }
+
+    GLuint id = glCreateProgram();
+    glProgramBinary(id, hdr.format, blob.data(),
+                    static_cast<GLsizei>(blob.size()));
+
+    GLint status = 0;
+    glGetProgramiv(id, GL_LINK_STATUS, &status);
+    if (status == 0) {
+        // the driver rejected the binary (e.g. after an update), drop it
+        glDeleteProgram(id);
+        return drop();
+    }
+
+    m_stats.hits += 1;
+    return shader_program{.id = id};
+}
+
+bool shader_cache::store(shader_cache_key key, shader_program p) noexcept {
+    if (!m_enabled || !key || !p) {
+        return false;
+    }
+
+    GLint length = 0;
+    glGetProgramiv(p.id, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        return false;
+    }
+
+    std::vector<char> blob(length);
+    GLenum format = GL_NONE;
+    glGetProgramBinary(p.id, length, &length, &format, blob.data());
+    if (length <= 0) {
+        return false;
+    }
+
+    const entry_header hdr{
+        .key = key.hash,
+        .format = format,
+        .length = static_cast<std::uint32_t>(length),
+    };
+
+    // write to a temporary file first, so readers never see partial entries
+    const auto path = entry_path(key);
+    auto tmp_path = path;
+    tmp_path += ".tmp";
+    {
+        std::ofstream out{tmp_path, std::ios::binary | std::ios::trunc};
+        out.write(reinterpret_cast<const char *>(&hdr), sizeof(hdr));
+        out.write(blob.data(), length);
+        if (!out) {
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmp_path, path, ec);
+    if (ec) {
+        std::filesystem::remove(tmp_path, ec);
+        return false;
+    }
+
+    m_stats.stores += 1;
+    return true;
+}
+
+shader_program shader_cache::make_shader(std::string_view vs_src,
+                                         std::string_view fs_src) noexcept {
+    if (!m_enabled) {
+        return tue::gfx::make_shader(vs_src, fs_src);
+    }
+
+    const auto key = make_key({vs_src, fs_src});
+    if (auto p = load(key)) {
+        return p;
+    }
+
+    auto p = tue::gfx::make_shader(vs_src, fs_src,
+                                   link_options{.binary_retrievable = true});
+    if (p) {
+        store(key, p);
+    }
+    return p;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+} // namespace tue::gfx
@@ -0,0 +1,199 @@
+#include <tuesday/gfx/shader_compiler.hpp>
+
+#include <algorithm>
+#include <print>
+#include <utility>
+
+namespace tue::gfx {
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+// same value for the KHR and ARB variants of the extension
+static constexpr GLenum completion_status = 0x91B1;
+
+static shader_stage submit_stage(std::string_view src, GLenum type) noexcept {
+    GLuint id = glCreateShader(type);
+
+    const GLchar *ptr = src.data();
+    const auto len = static_cast<GLint>(src.size());
+    glShaderSource(id, 1, &ptr, &len);
+    glCompileShader(id);
+
+    return shader_stage{id, type};
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+shader_compiler::shader_compiler() noexcept {
+#if defined(GL_KHR_parallel_shader_compile)
+    if (!m_parallel && GLAD_GL_KHR_parallel_shader_compile) {
+        glMaxShaderCompilerThreadsKHR(0xFFFFFFFFU);
+        m_parallel = true;
+    }
+#endif
+#if defined(GL_ARB_parallel_shader_compile)
+    if (!m_parallel && GLAD_GL_ARB_parallel_shader_compile) {
+        glMaxShaderCompilerThreadsARB(0xFFFFFFFFU);
+        m_parallel = true;
+    }
+#endif
+}
+
+shader_compiler::shader_compiler(shader_cache &cache) noexcept
+    : shader_compiler() {
+    m_cache = cache.enabled() ? &cache : nullptr;
+}
+
+shader_compiler::~shader_compiler() {
+    for (auto &job : m_jobs) {
+        delete_shader_stage(job.vs);
+        delete_shader_stage(job.fs);
+        delete_shader(job.prog);
+    }
+}
+
+shader_job shader_compiler::submit(std::string_view vs_src,
+                                   std::string_view fs_src) {
+    std::uint32_t id{0};
+    if (!m_free.empty()) {
+        id = m_free.back();
+        m_free.pop_back();
+    }
+    else {
+        m_jobs.emplace_back();
+        id = static_cast<std::uint32_t>(m_jobs.size());
+    }
+
+    auto &job = m_jobs[id - 1];
+    const auto gen = job.gen + 1;
+    job = job_data{};
+    job.gen = gen;
+
+    if (m_cache != nullptr) {
+        job.key = m_cache->make_key({vs_src, fs_src});
+        if (auto p = m_cache->load(job.key)) {
+            job.prog = p;
+            job.status = shader_job_status::ready;
+            return shader_job{id, gen};
+        }
+    }
+
+    job.vs = submit_stage(vs_src, GL_VERTEX_SHADER);
+    job.fs = submit_stage(fs_src, GL_FRAGMENT_SHADER);
+
+    // linking does not require the compile status to be known, so it is
+    // queued right away and the driver is free to pipeline both steps
+    job.prog.id = glCreateProgram();
+    if (m_cache != nullptr) {
+        glProgramParameteri(job.prog.id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT,
+                            GL_TRUE);
+    }
+    glAttachShader(job.prog.id, job.vs.id);
+    glAttachShader(job.prog.id, job.fs.id);
+    glLinkProgram(job.prog.id);
+
+    job.status = shader_job_status::pending;
+    m_pending.push_back(id);
+
+    return shader_job{id, gen};
+}
+
+std::size_t shader_compiler::poll() noexcept {
+    if (m_parallel) {
+        std::erase_if(m_pending, [this](std::uint32_t id) {
+            auto &job = m_jobs[id - 1];
+            if (!is_complete(job)) {
+                return false;
+            }
+            finalize(job);
+            return true;
+        });
+    }
+    else if (!m_pending.empty()) {
+        finalize(m_jobs[m_pending.front() - 1]);
+        m_pending.erase(m_pending.begin());
+    }
+    return m_pending.size();
+}
+
+void shader_compiler::wait_all() noexcept {
+    for (auto id : m_pending) {
+        finalize(m_jobs[id - 1]);
+    }
+    m_pending.clear();
+}
+
+shader_job_status shader_compiler::status(shader_job job) const noexcept {
+    if (!job || job.id > m_jobs.size() || m_jobs[job.id - 1].gen != job.gen) {
+        return shader_job_status::unknown;
+    }
+    return m_jobs[job.id - 1].status;
+}
+
+shader_program shader_compiler::take(shader_job job) noexcept {
+    auto *data = find(job);
+    if (data == nullptr) {
+        return {};
+    }
+
+    if (data->status == shader_job_status::pending) {
+        finalize(*data);
+        std::erase(m_pending, job.id);
+    }
+
+    data->status = shader_job_status::unknown;
+    m_free.push_back(job.id);
+    return std::exchange(data->prog, shader_program{});
+}
+
+bool shader_compiler::is_complete(const job_data &job) const noexcept {
+    GLint done = GL_FALSE;
+    glGetProgramiv(job.prog.id, completion_status, &done);
+    return done == GL_TRUE;
+}
+
+void shader_compiler::finalize(job_data &job) noexcept {
+    GLint status = 0;
+    glGetProgramiv(job.prog.id, GL_LINK_STATUS, &status);
+
+    if (status == 0) {
+        for (auto stage : {job.vs, job.fs}) {
+            GLint compiled = 0;
+            glGetShaderiv(stage.id, GL_COMPILE_STATUS, &compiled);
+            if (compiled == 0) {
+                std::println(stderr, "[gfx] shader compilation failed: {}",
+                             info_log(stage));
+            }
+        }
+        std::println(stderr, "[gfx] shader linking failed: {}",
+                     info_log(job.prog));
+        delete_shader(job.prog);
+        job.status = shader_job_status::failed;
+    }
+    else {
+        glDetachShader(job.prog.id, job.vs.id);
+        glDetachShader(job.prog.id, job.fs.id);
+        if (m_cache != nullptr) {
+            m_cache->store(job.key, job.prog);
+        }
+        job.status = shader_job_status::ready;
+    }
+
+    delete_shader_stage(job.vs);
+    delete_shader_stage(job.fs);
+}
+
+shader_compiler::job_data *shader_compiler::find(shader_job job) noexcept {
+    if (!job || job.id > m_jobs.size()) {
+        return nullptr;
+    }
+    auto &data = m_jobs[job.id - 1];
+    if (data.gen != job.gen || data.status == shader_job_status::unknown) {
+        return nullptr;
+    }
+    return &data;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+} // namespace tue::gfx
@@ -0,0 +1,137 @@
+#include <tuesday/gfx/upload_queue.hpp>
+
+#include <tuesday/assert.hpp>
+#include <tuesday/profile.hpp>
+
+#include <algorithm>
+
+namespace tue::gfx {
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+upload_queue::upload_queue(context_fn make_current, context_fn release) {
+    m_thread = std::jthread{[this, make_current = std::move(make_current),
+                             release = std::move(release)](
+                                std::stop_token stop) {
+        work(stop, make_current, release);
+    }};
+}
+
+upload_queue::~upload_queue() {
+    if (m_thread.joinable()) {
+        m_thread.request_stop();
+        m_thread.join();
+    }
+
+    for (auto &b : m_done) {
+        delete_fence(b.fence);
+        m_ready.insert(m_ready.end(), b.buffers.begin(), b.buffers.end());
+    }
+    for (auto &b : m_ready) {
+        glDeleteBuffers(1, &b.id);
+    }
+}
+
+std::uint64_t upload_queue::submit(std::span<const std::byte> bytes,
+                                   GLsizei stride, GLenum usage) {
+    tue_assert(stride > 0);
+    tue_assert(bytes.size() % static_cast<std::size_t>(stride) == 0);
+
+    job j{
+        .bytes = {bytes.begin(), bytes.end()},
+        .stride = stride,
+        .usage = usage,
+    };
+
+    if (!threaded()) {
+        j.ticket = ++m_last_ticket;
+        m_done.push_back({.fence = {}, .buffers = {run(j)}});
+        return j.ticket;
+    }
+
+    std::uint64_t ticket{0};
+    {
+        std::lock_guard lock{m_mutex};
+        ticket = j.ticket = ++m_last_ticket;
+        m_jobs.push_back(std::move(j));
+    }
+    m_wake.notify_one();
+    return ticket;
+}
+
+std::size_t upload_queue::in_flight() const {
+    std::lock_guard lock{m_mutex};
+    std::size_t n{m_jobs.size() + m_ready.size()};
+    for (const auto &b : m_done) {
+        n += b.buffers.size();
+    }
+    return n;
+}
+
+uploaded_buffer upload_queue::run(const job &j) {
+    uploaded_buffer b{
+        .ticket = j.ticket,
+        .stride = j.stride,
+        .count = static_cast<GLintptr>(j.bytes.size()) / j.stride,
+    };
+    glCreateBuffers(1, &b.id);
+    tue_assert(b.id != 0);
+    glNamedBufferData(b.id, static_cast<GLsizeiptr>(j.bytes.size()),
+                      j.bytes.data(), j.usage);
+    return b;
+}
+
+void upload_queue::work(std::stop_token stop, const context_fn &make_current,
+                        const context_fn &release) {
+    tue::profile::set_thread_name("upload");
+    make_current();
+
+    std::vector<job> jobs;
+    while (true) {
+        {
+            std::unique_lock lock{m_mutex};
+            if (!m_wake.wait(lock, stop, [this] { return !m_jobs.empty(); })) {
+                break; // stop requested
+            }
+            jobs.swap(m_jobs);
+        }
+
+        batch b;
+        {
+            tue_profile_scope("gfx.upload_queue.upload");
+            for (const auto &j : jobs) {
+                b.buffers.push_back(run(j));
+            }
+            b.fence = insert_fence();
+            // the render thread's checks flush only its own context
+            glFlush();
+        }
+        jobs.clear();
+
+        std::lock_guard lock{m_mutex};
+        m_done.push_back(std::move(b));
+    }
+
+    release();
+}
+
+void upload_queue::collect() {
+    std::lock_guard lock{m_mutex};
+
+    // fences signal in submission order
+    std::size_t n{0};
+    for (auto &b : m_done) {
+        if (b.fence && !is_signaled(b.fence)) {
+            break;
+        }
+        delete_fence(b.fence);
+        m_ready.insert(m_ready.end(), b.buffers.begin(), b.buffers.end());
+        ++n;
+    }
+    m_done.erase(m_done.begin(),
+                 m_done.begin() + static_cast<std::ptrdiff_t>(n));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+} // namespace tue::gfx
@@ -1,4 +1,6 @@
-#include <tuesday/wsi/window.hpp>
+#include <tuesday/wsi.hpp>
+
+#include <tuesday/profile.hpp>
 
 #include "glfw.hpp"
 
@@ -6,13 +8,6 @@ namespace tue::wsi {
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-window_watcher::window_watcher(window &owner) : m_owner{&owner} {
-}
-
-window_watcher::~window_watcher() = default;
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-
 window::window(window &&other) noexcept {
     other.swap(*this);
 }
@@ -35,7 +30,8 @@ void window::swap(window &other) noexcept {
         other.m_client->set_context(&other);
     }
 
-    m_watchers = std::exchange(other.m_watchers, std::move(m_watchers));
+    std::swap(m_handlers, other.m_handlers);
+    m_queue = std::exchange(other.m_queue, std::move(m_queue));
     m_attrs = std::exchange(other.m_attrs, m_attrs);
     m_normal_size = std::exchange(other.m_normal_size, m_normal_size);
 }
@@ -88,17 +84,16 @@ void window::set_attrs(window_attrs attrs) {
     }
 }
 
-window_watcher *window::make_watcher() {
-    m_watchers.emplace_back(new window_watcher(*this));
-    return m_watchers.back().get();
-}
-
-void window::remove_watcher(window_watcher *watcher) {
-    auto iter = std::ranges::find_if(
-        m_watchers, [w = watcher](auto &wp) { return wp.get() == w; });
-    if (iter != end(m_watchers)) {
-        m_watchers.erase(iter);
+void window::unwatch(watch_handle h) noexcept {
+    if (!h) {
+        return;
     }
+    std::apply(
+        [h](auto &...lists) {
+            std::uint32_t kind{0};
+            ((kind++ == h.kind && lists.remove(h.id)) || ...);
+        },
+        m_handlers);
 }
 
 void window::set_client(std::unique_ptr<window_client> client) {
@@ -124,42 +119,89 @@ window_mode window::get_default_mode() const noexcept {
     return m_attrs.mode;
 }
 
-void window::on_event(resize_event e) noexcept {
-    m_attrs.size = e.size;
-    if (m_attrs.mode != window_mode::fullscreen) {
-        m_normal_size = e.size;
+cursor_mode window::get_cursor_mode() const noexcept {
+    return m_attrs.cursor;
+}
+
+swap_interval window::get_swap_interval() const noexcept {
+    return m_attrs.swap;
+}
+
+void window::set_queued(bool queued) {
+    if (queued && !m_queue) {
+        m_queue = std::make_unique<event_queue>();
     }
-    for (auto &w : m_watchers) {
-        if (w->on_size) {
-            w->on_size(*this, e);
-        }
+    else if (!queued) {
+        m_queue.reset();
     }
 }
 
-void window::on_event(redraw_event /*e*/) noexcept {
-    for (auto &w : m_watchers) {
-        if (w->on_draw) {
-            w->on_draw(*this);
-        }
+std::size_t window::dispatch_events() {
+    if (!m_queue) {
+        return 0;
     }
+    return m_queue->drain([this](const any_event &e) {
+        std::visit([this](auto ev) { deliver(ev); }, e);
+    });
+}
+
+void window::on_event(resize_event e) noexcept {
+    // on the polling thread, even when queued: see set_queued
+    update_size(e);
+    if (m_queue) {
+        m_queue->push(e);
+        return;
+    }
+    deliver(e);
+}
+
+void window::on_event(redraw_event e) noexcept {
+    if (m_queue) {
+        m_queue->push(e);
+        return;
+    }
+    deliver(e);
 }
 
 void window::on_event(keyboard_event e) noexcept {
-    for (auto &w : m_watchers) {
-        if (w->on_keyboard) {
-            w->on_keyboard(*this, e);
-        }
+    if (m_queue) {
+        m_queue->push(e);
+        return;
     }
+    deliver(e);
 }
 
 void window::on_event(mouse_event e) noexcept {
-    for (auto &w : m_watchers) {
-        if (w->on_mouse) {
-            w->on_mouse(*this, e);
-        }
+    if (m_queue) {
+        m_queue->push(e);
+        return;
+    }
+    deliver(e);
+}
+
+void window::update_size(resize_event e) noexcept {
+    m_attrs.size = e.size;
+    if (m_attrs.mode != window_mode::fullscreen) {
+        m_normal_size = e.size;
     }
 }
 
+void window::deliver(resize_event e) noexcept {
+    handlers<resize_event>().call(*this, e);
+}
+
+void window::deliver(redraw_event e) noexcept {
+    handlers<redraw_event>().call(*this, e);
+}
+
+void window::deliver(keyboard_event e) noexcept {
+    handlers<keyboard_event>().call(*this, e);
+}
+
+void window::deliver(mouse_event e) noexcept {
+    handlers<mouse_event>().call(*this, e);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 window window_system::make_window(window_attrs attrs) {
@@ -172,9 +214,57 @@ window window_system::make_window(window_attrs attrs) {
 }
 
 void window_system::poll_events() {
+    tue_profile_scope("wsi.window_system.poll_events");
     if (m_client) {
         m_client->poll_events();
     }
+    deliver_injected();
+}
+
+void window_system::wait_events_until(
+    std::chrono::steady_clock::time_point deadline) {
+    using namespace std::chrono;
+
+    tue_profile_scope("wsi.window_system.wait_events");
+    if (m_client) {
+        auto timeout = nanoseconds::zero();
+        if (deadline == steady_clock::time_point::max()) {
+            timeout = nanoseconds::max();
+        }
+        else {
+            timeout = deadline - steady_clock::now();
+        }
+        m_client->wait_events_for(m_injected.empty() ? timeout
+                                                     : nanoseconds::zero());
+    }
+    deliver_injected();
+}
+
+void window_system::wake() noexcept {
+    if (m_client) {
+        m_client->wake();
+    }
+}
+
+void window_system::deliver_injected() {
+    // handlers may inject more: those wait for the next poll
+    m_delivering.swap(m_injected);
+    for (auto &[wnd, ev] : m_delivering) {
+        std::visit([w = wnd](auto e) { w->on_event(e); }, ev);
+    }
+    m_delivering.clear();
+}
+
+void window_system::inject(window &wnd, any_event e) {
+    const auto stamp = [](auto &ev) {
+        if constexpr (requires { ev.time; }) {
+            if (ev.time == event_time{}) {
+                ev.time = event_time::clock::now();
+            }
+        }
+    };
+    std::visit(stamp, e);
+    m_injected.emplace_back(&wnd, e);
 }
 
 gl_context window_system::make_gl_context() const noexcept {
@@ -190,15 +280,22 @@ void window_system::make_current(window &wnd) {
     }
 }
 
+worker_context window_system::make_worker_context() {
+    if (m_client) {
+        return worker_context{m_client->make_worker_context()};
+    }
+    return {};
+}
+
 void window_system::set_client(std::unique_ptr<window_system_client> client) {
     m_client = std::move(client);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-window_system connect() {
+window_system connect(connect_options opts) {
     window_system ws;
-    ws.set_client(glfw::make_window_system_client());
+    ws.set_client(glfw::make_window_system_client(opts.headless));
     return ws;
 }
 
@@ -0,0 +1,67 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <tuesday/utility/delegate.hpp>
+
+#include <type_traits>
+#include <vector>
+
+static int twice(int x) {
+    return 2 * x;
+}
+
+TEST_SUITE("delegate") {
+
+    using int_fn = tue::delegate<int(int)>;
+
+    static_assert(std::is_trivially_copyable_v<int_fn>);
+    static_assert(sizeof(int_fn) <= 64);
+
+    TEST_CASE("empty") {
+        int_fn f;
+        CHECK_FALSE(f);
+        int_fn g = nullptr;
+        CHECK_FALSE(g);
+    }
+
+    TEST_CASE("function pointer") {
+        int_fn f = twice;
+        REQUIRE(f);
+        CHECK_EQ(f(21), 42);
+    }
+
+    TEST_CASE("lambda with captures") {
+        int base{10};
+        int calls{0};
+        int_fn f = [&base, &calls](int x) {
+            ++calls;
+            return base + x;
+        };
+        CHECK_EQ(f(1), 11);
+        base = 20;
+        CHECK_EQ(f(1), 21);
+        CHECK_EQ(calls, 2);
+    }
+
+    TEST_CASE("mutable target keeps its state across copies") {
+        int_fn f = [n = 0](int x) mutable { return n += x; };
+        CHECK_EQ(f(1), 1);
+        CHECK_EQ(f(1), 2);
+
+        int_fn g = f; // copies the state as it is now
+        CHECK_EQ(g(1), 3);
+        CHECK_EQ(f(1), 3);
+    }
+
+    TEST_CASE("stored by value in a vector") {
+        int sum{0};
+        std::vector<tue::delegate<void(int)>> fns;
+        for (int k{1}; k <= 100; ++k) {
+            fns.emplace_back([&sum, k](int x) { sum += k * x; });
+        }
+        for (const auto &f : fns) {
+            f(1);
+        }
+        CHECK_EQ(sum, 5050);
+    }
+}
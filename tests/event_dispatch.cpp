@@ -0,0 +1,61 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <nanobench.h>
+
+#include <tuesday/wsi.hpp>
+
+// Cost of getting a burst of cursor moves, as a 1000 Hz mouse produces
+// between two polls, to the handlers. Injected events take the same
+// `window::on_event` path as the ones from the GLFW callbacks, but only
+// from there: the backend's own step before it, finding the window behind
+// a GLFWwindow (glfwGetWindowUserPointer), is not measured here.
+
+TEST_SUITE("event_dispatch") {
+    using namespace tue::wsi;
+
+    constexpr int burst = 16; // ~16ms worth of 1000 Hz input per frame
+
+    void inject_burst(window_system &ws, window &wnd) {
+        for (int i{0}; i < burst; ++i) {
+            ws.inject(wnd, mouse_event{.pos = {double(i), double(i)}});
+        }
+    }
+
+    TEST_CASE("cursor move bursts") {
+        window_system ws;
+        window wnd = ws.make_window();
+
+        double sum{0.};
+        wnd.watch<mouse_event>(
+            [&](window &, mouse_event e) { sum += e.pos.x; });
+
+        ankerl::nanobench::Bench bench;
+        bench.title("cursor move burst").unit("event").batch(burst);
+
+        bench.run("direct handlers", [&] {
+            inject_burst(ws, wnd);
+            ws.poll_events();
+        });
+
+        wnd.set_queued(true);
+        bench.run("queued, dispatch_events", [&] {
+            inject_burst(ws, wnd);
+            ws.poll_events();
+            wnd.dispatch_events();
+        });
+
+        bench.run("queued, drain_events", [&] {
+            inject_burst(ws, wnd);
+            ws.poll_events();
+            wnd.drain_events([&](const any_event &e) {
+                if (const auto *m = std::get_if<mouse_event>(&e)) {
+                    sum += m->pos.x;
+                }
+            });
+        });
+
+        ankerl::nanobench::doNotOptimizeAway(sum);
+        CHECK_EQ(wnd.dropped_events(), 0);
+    }
+}
@@ -0,0 +1,182 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <tuesday/wsi.hpp>
+
+#include <chrono>
+#include <vector>
+
+TEST_SUITE("event_inject") {
+
+    TEST_CASE("delivered by the next poll, in order") {
+        using namespace tue::wsi;
+
+        window_system ws; // no platform client: injected events only
+        window wnd = ws.make_window();
+
+        std::vector<key_code> keys;
+        window_size size{};
+        wnd.watch<keyboard_event>(
+            [&](window &, keyboard_event e) { keys.push_back(e.code); });
+        wnd.watch<resize_event>(
+            [&](window &, resize_event e) { size = e.size; });
+
+        ws.inject(wnd, keyboard_event{.code = key_code::A,
+                                      .act = key_action::pressed});
+        ws.inject(wnd, resize_event{.size = {320, 240}});
+        ws.inject(wnd, keyboard_event{.code = key_code::B,
+                                      .act = key_action::pressed});
+        CHECK(keys.empty());
+
+        ws.poll_events();
+        const std::vector expected{key_code::A, key_code::B};
+        CHECK_EQ(keys, expected);
+        CHECK_EQ(size.width, 320);
+        CHECK_EQ(wnd.get_attrs().size.height, 240);
+
+        ws.poll_events();
+        CHECK_EQ(keys.size(), 2);
+    }
+
+    TEST_CASE("events injected by handlers wait for the next poll") {
+        using namespace tue::wsi;
+
+        window_system ws;
+        window wnd = ws.make_window();
+
+        int seen{0};
+        wnd.watch<keyboard_event>([&](window &w, keyboard_event e) {
+            ++seen;
+            if (e.pressed(key_code::space)) {
+                ws.inject(w, keyboard_event{.code = key_code::escape,
+                                            .act = key_action::pressed});
+            }
+        });
+
+        ws.inject(wnd, keyboard_event{.code = key_code::space,
+                                      .act = key_action::pressed});
+        ws.poll_events();
+        CHECK_EQ(seen, 1);
+        ws.poll_events();
+        CHECK_EQ(seen, 2);
+    }
+
+    TEST_CASE("queued window delivers on dispatch") {
+        using namespace tue::wsi;
+
+        window_system ws;
+        window wnd = ws.make_window();
+        wnd.set_queued(true);
+
+        int moves{0};
+        wnd.watch<mouse_event>([&](window &, mouse_event) { ++moves; });
+
+        for (int i{0}; i < 10; ++i) {
+            ws.inject(wnd, mouse_event{.pos = {double(i), 0}});
+        }
+        ws.poll_events();
+        CHECK_EQ(moves, 0);
+
+        // ten cursor moves in a row collapse into one
+        CHECK_EQ(wnd.dispatch_events(), 1);
+        CHECK_EQ(moves, 1);
+    }
+
+    TEST_CASE("queued window takes its size when polled") {
+        using namespace tue::wsi;
+
+        window_system ws;
+        window wnd = ws.make_window();
+        wnd.set_queued(true);
+
+        window_size seen{};
+        wnd.watch<resize_event>(
+            [&](window &, resize_event e) { seen = e.size; });
+
+        ws.inject(wnd, resize_event{.size = {320, 240}});
+        ws.poll_events();
+        // applied by the polling thread, before any dispatch
+        CHECK_EQ(wnd.get_attrs().size.width, 320);
+        CHECK_EQ(seen.width, 0);
+
+        CHECK_EQ(wnd.dispatch_events(), 1);
+        CHECK_EQ(seen.width, 320);
+        CHECK_EQ(wnd.get_attrs().size.height, 240);
+    }
+
+    TEST_CASE("handlers unwatched by handle, also while called") {
+        using namespace tue::wsi;
+
+        window_system ws;
+        window wnd = ws.make_window();
+
+        int first{0};
+        int second{0};
+        int late{0};
+        watch_handle h2{};
+        const auto h1 = wnd.watch<keyboard_event>([&](window &w, auto) {
+            ++first;
+            // runs after this event, not within it
+            w.watch<keyboard_event>([&](window &, auto) { ++late; });
+            w.unwatch(h2);
+        });
+        h2 = wnd.watch<keyboard_event>([&](window &, auto) { ++second; });
+        CHECK(h1);
+        CHECK_NE(h1.id, h2.id);
+
+        ws.inject(wnd, keyboard_event{.code = key_code::A});
+        ws.poll_events();
+        CHECK_EQ(first, 1);
+        CHECK_EQ(second, 0);
+        CHECK_EQ(late, 0);
+
+        wnd.unwatch(h1);
+        wnd.unwatch(h1); // already gone
+        ws.inject(wnd, keyboard_event{.code = key_code::A});
+        ws.poll_events();
+        CHECK_EQ(first, 1);
+        CHECK_EQ(late, 1);
+    }
+
+    TEST_CASE("waiting delivers injected events without blocking") {
+        using namespace tue::wsi;
+        using clock = std::chrono::steady_clock;
+
+        window_system ws;
+        window wnd = ws.make_window();
+
+        int seen{0};
+        wnd.watch<keyboard_event>([&](window &, auto) { ++seen; });
+
+        ws.inject(wnd, keyboard_event{.code = key_code::A});
+        const auto t0 = clock::now();
+        ws.wait_events_until(t0 + std::chrono::seconds{10});
+        CHECK_EQ(seen, 1);
+        CHECK_LT(clock::now() - t0, std::chrono::seconds{1});
+
+        ws.wake(); // nothing to wake: a no-op
+        ws.wait_events_until(clock::time_point::max());
+        CHECK_EQ(seen, 1);
+    }
+
+    TEST_CASE("injected input is time stamped") {
+        using namespace tue::wsi;
+
+        window_system ws;
+        window wnd = ws.make_window();
+
+        std::vector<event_time> times;
+        wnd.watch<mouse_event>(
+            [&](window &, mouse_event e) { times.push_back(e.time); });
+
+        const auto t0 = event_time::clock::now();
+        const auto given = t0 - std::chrono::seconds{1};
+        ws.inject(wnd, mouse_event{.pos = {1, 1}});
+        ws.inject(wnd, mouse_event{.pos = {2, 2}, .time = given});
+        ws.poll_events();
+
+        REQUIRE_EQ(times.size(), 2);
+        CHECK_GE(times[0], t0);
+        CHECK_EQ(times[1], given);
+    }
+}
@@ -0,0 +1,85 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <tuesday/wsi/event_queue.hpp>
+
+#include <thread>
+#include <vector>
+
+TEST_SUITE("event_queue") {
+    using namespace tue::wsi;
+
+    TEST_CASE("coalesces runs of resizes and cursor moves") {
+        event_queue q;
+        q.push(mouse_event{.pos = {1, 1}});
+        q.push(mouse_event{.pos = {2, 2}});
+        q.push(mouse_event{.code = key_code::mouse_left,
+                           .act = key_action::pressed,
+                           .pos = {2, 2}});
+        q.push(mouse_event{.pos = {3, 3}});
+        q.push(resize_event{.size = {10, 10}});
+        q.push(resize_event{.size = {20, 20}});
+        q.push(keyboard_event{.code = key_code::A, .act = key_action::pressed});
+        q.push(keyboard_event{.code = key_code::A, .act = key_action::pressed});
+
+        std::vector<any_event> out;
+        CHECK_EQ(q.drain([&](const any_event &e) { out.push_back(e); }), 6);
+        REQUIRE_EQ(out.size(), 6);
+
+        CHECK_EQ(std::get<mouse_event>(out[0]).pos.x, 2);
+        CHECK(std::get<mouse_event>(out[1]).pressed(key_code::mouse_left));
+        CHECK_EQ(std::get<mouse_event>(out[2]).pos.x, 3);
+        CHECK_EQ(std::get<resize_event>(out[3]).size.width, 20);
+        // key events are never merged
+        CHECK(std::holds_alternative<keyboard_event>(out[4]));
+        CHECK(std::holds_alternative<keyboard_event>(out[5]));
+
+        CHECK_EQ(q.drain([](const any_event &) {}), 0);
+    }
+
+    TEST_CASE("coalesced cursor moves keep their total motion") {
+        event_queue q;
+        q.push(mouse_event{.pos = {1, 0}, .delta = {1, 0}});
+        q.push(mouse_event{.pos = {3, 1}, .delta = {2, 1}});
+        q.push(mouse_event{.pos = {6, 1}, .delta = {3, 0}});
+
+        std::vector<any_event> out;
+        CHECK_EQ(q.drain([&](const any_event &e) { out.push_back(e); }), 1);
+        REQUIRE_EQ(out.size(), 1);
+        const auto &m = std::get<mouse_event>(out[0]);
+        CHECK_EQ(m.pos.x, 6);
+        CHECK_EQ(m.delta.x, 6);
+        CHECK_EQ(m.delta.y, 1);
+    }
+
+    TEST_CASE("drops when full") {
+        event_queue q;
+        for (std::size_t i{0}; i < event_queue::capacity + 3; ++i) {
+            q.push(keyboard_event{.code = key_code::A});
+        }
+        CHECK_EQ(q.dropped(), 3);
+        CHECK_EQ(q.drain([](const any_event &) {}), event_queue::capacity);
+    }
+
+    TEST_CASE("producer and consumer threads") {
+        constexpr int n = 100'000;
+        event_queue q;
+
+        std::thread producer{[&] {
+            for (int i{0}; i < n;) {
+                // key presses are never coalesced, so all must arrive
+                if (q.push(keyboard_event{.code = key_code::A,
+                                          .act = key_action::pressed})) {
+                    ++i;
+                }
+            }
+        }};
+
+        int seen{0};
+        while (seen < n) {
+            seen += static_cast<int>(q.drain([](const any_event &) {}));
+        }
+        producer.join();
+        CHECK_EQ(seen, n);
+    }
+}
@@ -0,0 +1,64 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <tuesday/wsi/frame_pacer.hpp>
+
+#include <chrono>
+
+TEST_SUITE("frame_pacer") {
+    using namespace std::chrono_literals;
+    using tue::wsi::frame_pacer;
+
+    // a 60 Hz display, swaps returning at vblanks with some jitter
+    constexpr auto refresh = 16'667us;
+
+    frame_pacer::time_point feed(frame_pacer & p, int swaps) {
+        frame_pacer::time_point t{1s};
+        for (int i{0}; i < swaps; ++i) {
+            const auto jitter = std::chrono::microseconds{(i * 37) % 200};
+            // every 10th frame misses its vblank
+            t += (i % 10 == 9) ? 2 * refresh : refresh;
+            p.add_swap(t + jitter);
+            p.add_work(4ms + jitter);
+        }
+        return t;
+    }
+
+    TEST_CASE("nothing to predict from yet") {
+        frame_pacer p;
+        const frame_pacer::time_point t{5s};
+        CHECK_EQ(p.period(), frame_pacer::duration::zero());
+        CHECK_EQ(p.next_vblank(t), t);
+        CHECK_EQ(p.frame_start(t), t);
+    }
+
+    TEST_CASE("period survives missed vblanks") {
+        frame_pacer p;
+        feed(p, 64);
+        CHECK_GE(p.period(), refresh - 200us);
+        CHECK_LE(p.period(), refresh + 200us);
+        CHECK_GE(p.work_estimate(), 4ms);
+        CHECK_LT(p.work_estimate(), 5ms);
+    }
+
+    TEST_CASE("frames start just in time") {
+        frame_pacer p;
+        const auto last = feed(p, 64);
+
+        // right after a swap: wait until the work just fits before the next
+        const auto t = last + 1ms;
+        const auto v = p.next_vblank(t);
+        CHECK_GT(v, t);
+        CHECK_LE(v - t, refresh);
+
+        const auto start = p.frame_start(t);
+        CHECK_GT(start, t);
+        CHECK_EQ(v - start, p.work_estimate() + p.margin);
+
+        // too close to the vblank for the work: aim for the one after
+        const auto late = v - 2ms;
+        const auto next = p.frame_start(late);
+        CHECK_GT(next, v);
+        CHECK_EQ(next, v + p.period() - p.work_estimate() - p.margin);
+    }
+}
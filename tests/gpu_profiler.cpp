@@ -0,0 +1,108 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <tuesday/gfx/gpu_profiler.hpp>
+
+#include "headless_gl.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Runs wherever a headless context has timer queries (e.g. Mesa's
+// software rasterizers). Every frame is finished before the next begins,
+// so results come back without drops.
+
+namespace {
+
+using scope = tue::gfx::gpu_profiler::scope;
+
+} // namespace
+
+TEST_SUITE("gpu_profiler") {
+
+    TEST_CASE("nested scopes come back in begin order") {
+        headless_gl gl;
+        if (!gl) {
+            return;
+        }
+
+        constexpr std::size_t frames_in_flight = 3;
+        tue::gfx::gpu_profiler prof{frames_in_flight};
+
+        bool fresh{false};
+        for (std::size_t f{0}; f <= frames_in_flight; ++f) {
+            fresh = prof.begin_frame();
+            {
+                scope a{prof, "a"};
+                {
+                    scope b{prof, "b"};
+                    scope c{prof, "c"};
+                }
+                scope d{prof, "d"};
+            }
+            {
+                scope e{prof, "e"};
+            }
+            prof.end_frame();
+            glFinish();
+        }
+
+        if (!prof.enabled()) {
+            MESSAGE("no timer queries: skipped");
+            return;
+        }
+
+        CHECK(fresh);
+        CHECK_EQ(prof.dropped(), 0);
+        CHECK_GE(prof.frame_ms(), 0.);
+
+        const auto r = prof.results();
+        REQUIRE_EQ(r.size(), 5);
+        const std::vector<std::string> names{"a", "b", "c", "d", "e"};
+        const std::vector<std::uint32_t> depths{0, 1, 2, 1, 0};
+        for (std::size_t i{0}; i < r.size(); ++i) {
+            CAPTURE(i);
+            CHECK_EQ(std::string{r[i].name}, names[i]);
+            CHECK_EQ(r[i].depth, depths[i]);
+            CHECK_GE(r[i].start_ms, 0.);
+            CHECK_GE(r[i].ms, 0.);
+        }
+        CHECK_LE(r[0].start_ms, r[1].start_ms);
+        CHECK_LE(r[3].start_ms, r[4].start_ms);
+    }
+
+    TEST_CASE("the query pool grows with the scopes of a frame") {
+        headless_gl gl;
+        if (!gl) {
+            return;
+        }
+
+        constexpr std::size_t frames_in_flight = 2;
+        constexpr std::size_t count = 40;
+        tue::gfx::gpu_profiler prof{frames_in_flight};
+
+        for (std::size_t f{0}; f <= frames_in_flight; ++f) {
+            prof.begin_frame();
+            for (std::size_t i{0}; i < count; ++i) {
+                prof.begin("nested");
+            }
+            for (std::size_t i{0}; i < count; ++i) {
+                prof.end();
+            }
+            prof.end_frame();
+            glFinish();
+        }
+
+        if (!prof.enabled()) {
+            MESSAGE("no timer queries: skipped");
+            return;
+        }
+
+        const auto r = prof.results();
+        REQUIRE_EQ(r.size(), count);
+        CHECK_EQ(r.back().depth, count - 1);
+        CHECK_GE(prof.frame_ms(), 0.);
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <doctest/doctest.h>
+
+#include <tuesday/gfx/gl.hpp>
+#include <tuesday/wsi.hpp>
+
+/// A GL context without a display, current on the calling thread: a
+/// worker context of a headless window system, with GL loaded. False where
+/// none can be created; tests are then skipped.
+struct headless_gl {
+    tue::wsi::window_system ws{tue::wsi::connect({.headless = true})};
+    tue::wsi::worker_context ctx{ws.make_worker_context()};
+    bool loaded{false};
+
+    headless_gl() {
+        if (!ctx) {
+            MESSAGE("no headless GL context: skipped");
+            return;
+        }
+        ctx.make_current();
+        loaded = gladLoadGL(ws.make_gl_context().proc_addr) != 0;
+        if (!loaded) {
+            MESSAGE("failed to load OpenGL: skipped");
+        }
+    }
+
+    ~headless_gl() { ctx.release(); }
+
+    headless_gl(const headless_gl &) = delete;
+    headless_gl &operator=(const headless_gl &) = delete;
+
+    explicit operator bool() const noexcept { return loaded; }
+};
@@ -0,0 +1,95 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <tuesday/utility/histogram.hpp>
+
+#include <cstdint>
+#include <random>
+#include <thread>
+#include <vector>
+
+TEST_SUITE("histogram") {
+
+    TEST_CASE("bucket bounds") {
+        using h = tue::histogram;
+        static_assert(h::bucket_of(0) == 0);
+        static_assert(h::bucket_of(h::sub_count - 1) == h::sub_count - 1);
+        static_assert(h::bucket_of(h::max_trackable) == h::bucket_count - 1);
+        static_assert(h::bucket_of(~std::uint64_t{0}) == h::bucket_count - 1);
+
+        std::mt19937_64 rng{1};
+        for (int i{0}; i < 10000; ++i) {
+            const auto v = rng() >> (rng() % 40 + 24);
+            const auto b = h::bucket_of(v);
+            REQUIRE_LE(h::bucket_lower(b), v);
+            REQUIRE_GE(h::bucket_upper(b), v);
+            // relative bucket width is bounded by the sub-bucket count
+            REQUIRE_LE(h::bucket_upper(b) - h::bucket_lower(b),
+                       h::bucket_lower(b) / h::sub_count);
+        }
+    }
+
+    TEST_CASE("percentiles") {
+        tue::histogram h;
+        CHECK_EQ(h.percentile(50), 0);
+
+        for (std::uint64_t v{1}; v <= 10000; ++v) {
+            h.record(v);
+        }
+
+        const auto s = h.summary();
+        CHECK_EQ(s.count, 10000);
+        CHECK_EQ(s.min, 1);
+        CHECK_EQ(s.max, 10000);
+        CHECK_EQ(s.mean, doctest::Approx(5000.5));
+
+        const auto near = [](std::uint64_t got, std::uint64_t want) {
+            const auto d = got > want ? got - want : want - got;
+            return d <= want / 100;
+        };
+        CHECK(near(s.p50, 5000));
+        CHECK(near(s.p95, 9500));
+        CHECK(near(s.p99, 9900));
+        CHECK_EQ(h.percentile(100), 10000);
+        CHECK_EQ(h.percentile(0), 1);
+    }
+
+    TEST_CASE("outlier shows in max only") {
+        tue::histogram h;
+        for (int i{0}; i < 999; ++i) {
+            h.record(1000);
+        }
+        h.record(50000);
+        const auto s = h.summary();
+        CHECK_LT(s.p99, 1010);
+        CHECK_EQ(s.max, 50000);
+    }
+
+    TEST_CASE("concurrent record and merge") {
+        tue::histogram h;
+        std::vector<std::thread> ts;
+        for (int t{0}; t < 4; ++t) {
+            ts.emplace_back([&h, t] {
+                for (std::uint64_t i{0}; i < 10000; ++i) {
+                    h.record(i * 4 + t);
+                }
+            });
+        }
+        for (auto &t : ts) {
+            t.join();
+        }
+        CHECK_EQ(h.count(), 40000);
+        CHECK_EQ(h.min(), 0);
+        CHECK_EQ(h.max(), 39999);
+
+        tue::histogram total;
+        total.merge(h);
+        total.merge(h);
+        CHECK_EQ(total.count(), 80000);
+        CHECK_EQ(total.max(), 39999);
+
+        h.reset();
+        CHECK_EQ(h.count(), 0);
+        CHECK_EQ(h.summary().p99, 0);
+    }
+}
@@ -0,0 +1,90 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <tuesday/gfx/mesh_batch.hpp>
+
+#include <array>
+#include <cstdint>
+
+// Command bookkeeping only: nothing here is uploaded, so no GL context is
+// needed.
+
+namespace {
+
+using namespace tue::gfx;
+
+struct vertex {
+    float x, y, z;
+};
+
+constexpr std::array<vertex, 3> tri{};
+constexpr std::array<vertex, 4> quad{};
+constexpr std::array<std::uint32_t, 6> quad_indices{0, 1, 2, 2, 3, 0};
+
+} // namespace
+
+TEST_SUITE("mesh_batch") {
+
+    TEST_CASE("meshes are appended back to back") {
+        mesh_batch<vertex> batch;
+
+        const auto a = batch.add(std::span{tri});
+        const auto b = batch.add(std::span{quad}, std::span{quad_indices});
+        const auto c = batch.add(std::span{quad}, std::span{quad_indices});
+
+        CHECK(a.first_vertex == 0);
+        CHECK(a.vertex_count == 3);
+        CHECK_FALSE(a.indexed());
+
+        CHECK(b.first_vertex == 3);
+        CHECK(b.first_index == 0);
+        CHECK(b.index_count == 6);
+
+        CHECK(c.first_vertex == 7);
+        CHECK(c.first_index == 6);
+
+        CHECK(batch.vertex_count() == 11);
+        CHECK(batch.index_count() == 12);
+    }
+
+    TEST_CASE("push splits array and element commands") {
+        mesh_batch<vertex> batch;
+        const auto a = batch.add(std::span{tri});
+        const auto b = batch.add(std::span{quad}, std::span{quad_indices});
+        const auto c = batch.add(std::span{quad}, std::span{quad_indices});
+
+        indirect_commands cmds;
+        CHECK(cmds.empty());
+        CHECK(cmds.elements_offset() == 0);
+
+        cmds.push(b, 2, 0);
+        cmds.push(a, 1, 2);
+        cmds.push(c, 5, 3);
+
+        const auto arrays = cmds.arrays();
+        REQUIRE(arrays.size() == 1);
+        CHECK(arrays[0].count == 3);
+        CHECK(arrays[0].instance_count == 1);
+        CHECK(arrays[0].first == 0);
+        CHECK(arrays[0].base_instance == 2);
+
+        const auto elems = cmds.elements();
+        REQUIRE(elems.size() == 2);
+        CHECK(elems[0].count == 6);
+        CHECK(elems[0].first_index == 0);
+        CHECK(elems[0].base_vertex == 3);
+        CHECK(elems[0].instance_count == 2);
+        CHECK(elems[0].base_instance == 0);
+        CHECK(elems[1].first_index == 6);
+        CHECK(elems[1].base_vertex == 7);
+        CHECK(elems[1].instance_count == 5);
+        CHECK(elems[1].base_instance == 3);
+
+        // element commands follow the array ones in the GL buffer
+        CHECK(cmds.elements_offset() == 16);
+
+        cmds.clear();
+        CHECK(cmds.empty());
+        CHECK(cmds.elements_offset() == 0);
+    }
+}
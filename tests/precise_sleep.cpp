@@ -0,0 +1,30 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <tuesday/utility/precise_sleep.hpp>
+
+#include <chrono>
+
+TEST_SUITE("precise_sleep") {
+
+    TEST_CASE("wakes at the deadline") {
+        using namespace std::chrono_literals;
+        using clock = std::chrono::steady_clock;
+
+        for (std::chrono::microseconds d : {0us, 100us, 2000us, 10000us}) {
+            const auto deadline = clock::now() + d;
+            tue::precise_sleep_until(deadline);
+            const auto late = clock::now() - deadline;
+            CHECK_GE(late.count(), 0);
+            // generous: only catches sleeping a whole timer tick too long
+            CHECK_LT(late, 5ms);
+        }
+    }
+
+    TEST_CASE("past deadline returns at once") {
+        using clock = std::chrono::steady_clock;
+        const auto t = clock::now();
+        tue::precise_sleep_until(t - std::chrono::seconds{1});
+        CHECK_LT(clock::now() - t, std::chrono::milliseconds{1});
+    }
+}
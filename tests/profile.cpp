@@ -0,0 +1,95 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <tuesday/profile.hpp>
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// scope objects rather than the macro, which TUE_PROFILE_NOOP removes
+void nested() {
+    const tue::profile::scope outer{"outer"};
+    {
+        const tue::profile::scope inner{"inner"};
+    }
+}
+
+} // namespace
+
+TEST_SUITE("profile") {
+
+    TEST_CASE("disabled records nothing") {
+        std::vector<tue::profile::event> events;
+        tue::profile::drain(events);
+        events.clear();
+
+        tue::profile::set_enabled(false);
+        nested();
+        CHECK_EQ(tue::profile::drain(events), 0);
+    }
+
+    TEST_CASE("nested scopes") {
+        std::vector<tue::profile::event> events;
+        tue::profile::set_enabled(true);
+        nested();
+        tue::profile::set_enabled(false);
+
+        REQUIRE_EQ(tue::profile::drain(events), 2);
+        // recorded when they end: inner first, enclosed by outer
+        CHECK_EQ(std::string_view{events[0].name}, "inner");
+        CHECK_EQ(std::string_view{events[1].name}, "outer");
+        CHECK_LE(events[1].begin_ns, events[0].begin_ns);
+        CHECK_GE(events[1].end_ns, events[0].end_ns);
+        CHECK_EQ(events[0].thread, events[1].thread);
+    }
+
+    TEST_CASE("threads and trace export") {
+        std::vector<tue::profile::event> events;
+        tue::profile::set_enabled(true);
+
+        std::thread worker{[] {
+            tue::profile::set_thread_name("worker \"1\"");
+            nested();
+        }};
+        worker.join();
+        nested();
+        tue::profile::set_enabled(false);
+
+        // the exited worker's events are still there
+        REQUIRE_EQ(tue::profile::drain(events), 4);
+        CHECK_NE(events.front().thread, events.back().thread);
+
+        std::ostringstream out;
+        tue::profile::write_chrome_trace(out, events);
+        const auto json = out.str();
+
+        CHECK(json.starts_with(R"({"displayTimeUnit":"ms","traceEvents":[)"));
+        CHECK(json.ends_with("]}\n"));
+        CHECK_EQ(std::ranges::count(json, '{'), std::ranges::count(json, '}'));
+        // one line per event and thread name, plus the brackets
+        CHECK_EQ(std::ranges::count(json, '\n'), 4 + 1 + 2);
+        CHECK_NE(json.find(R"("args":{"name":"worker \"1\""})"),
+                 std::string::npos);
+        CHECK_NE(json.find(R"("ph":"X")"), std::string::npos);
+        CHECK_NE(json.find(R"("name":"inner")"), std::string::npos);
+    }
+
+    TEST_CASE("timestamps in microseconds") {
+        std::vector<tue::profile::event> events{
+            {.name = "a", .begin_ns = 1000, .end_ns = 2'501'007, .thread = 0},
+            {.name = "b", .begin_ns = 1500, .end_ns = 1600, .thread = 0},
+        };
+        std::ostringstream out;
+        tue::profile::write_chrome_trace(out, events);
+        const auto json = out.str();
+
+        CHECK_NE(json.find(R"("ts":0.000,"dur":2500.007)"), std::string::npos);
+        CHECK_NE(json.find(R"("ts":0.500,"dur":0.100)"), std::string::npos);
+    }
+}
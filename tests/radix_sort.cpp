@@ -0,0 +1,66 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <tuesday/utility/radix_sort.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+TEST_SUITE("radix_sort") {
+
+    TEST_CASE("empty and single") {
+        std::vector<std::uint32_t> v, tmp;
+        tue::radix_sort(std::span{v}, std::span{tmp});
+        CHECK(v.empty());
+
+        v = {42};
+        tmp.resize(1);
+        tue::radix_sort(std::span{v}, std::span{tmp});
+        CHECK_EQ(v.front(), 42);
+    }
+
+    TEST_CASE("matches std::sort") {
+        std::mt19937_64 rng{42};
+        std::vector<std::uint64_t> v(1000);
+        for (auto &x : v) {
+            x = rng();
+        }
+        auto expected = v;
+        std::ranges::sort(expected);
+
+        std::vector<std::uint64_t> tmp(v.size());
+        tue::radix_sort(std::span{v}, std::span{tmp});
+        CHECK(v == expected);
+    }
+
+    TEST_CASE("shared digits are skipped") {
+        // only the lowest byte differs: one pass, result lands in scratch
+        // and must be moved back
+        std::vector<std::uint64_t> v{0xAB00000000000003, 0xAB00000000000001,
+                                     0xAB00000000000002};
+        std::vector<std::uint64_t> tmp(v.size());
+        tue::radix_sort(std::span{v}, std::span{tmp});
+        CHECK_EQ(v[0], 0xAB00000000000001);
+        CHECK_EQ(v[1], 0xAB00000000000002);
+        CHECK_EQ(v[2], 0xAB00000000000003);
+    }
+
+    TEST_CASE("stable with projection") {
+        struct item {
+            std::uint16_t key;
+            int order;
+        };
+
+        std::vector<item> v{{2, 0}, {1, 1}, {2, 2}, {1, 3}, {0x100, 4}};
+        std::vector<item> tmp(v.size());
+        tue::radix_sort(std::span{v}, std::span{tmp}, &item::key);
+
+        CHECK_EQ(v[0].order, 1);
+        CHECK_EQ(v[1].order, 3);
+        CHECK_EQ(v[2].order, 0);
+        CHECK_EQ(v[3].order, 2);
+        CHECK_EQ(v[4].order, 4);
+    }
+}
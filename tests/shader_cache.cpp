@@ -0,0 +1,91 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <tuesday/gfx/shader_cache.hpp>
+
+#include "headless_gl.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+
+namespace {
+
+constexpr std::string_view vs_src = R"(
+    #version 330 core
+    void main() { gl_Position = vec4(0.0, 0.0, 0.0, 1.0); }
+)";
+
+constexpr std::string_view fs_src = R"(
+    #version 330 core
+    out vec4 color;
+    void main() { color = vec4(1.0); }
+)";
+
+} // namespace
+
+TEST_SUITE("shader_cache") {
+
+    TEST_CASE("keys are stable and keep sources apart") {
+        // no context: the keys hash the sources alone
+        const tue::gfx::shader_cache cache;
+        const auto key = cache.make_key({"ab", "c"});
+        CHECK(key);
+        CHECK_EQ(key, cache.make_key({"ab", "c"}));
+        CHECK_EQ(key, tue::gfx::shader_cache{}.make_key({"ab", "c"}));
+        CHECK_NE(key, cache.make_key({"a", "bc"}));
+        CHECK_NE(key, cache.make_key({"abc"}));
+        CHECK_NE(key, cache.make_key({"c", "ab"}));
+    }
+
+    TEST_CASE("stored programs load back, corrupt entries are dropped") {
+        headless_gl gl;
+        if (!gl) {
+            return;
+        }
+
+        const auto dir =
+            std::filesystem::temp_directory_path() / "tue_test_shader_cache";
+        std::filesystem::remove_all(dir);
+
+        tue::gfx::shader_cache cache{dir};
+        if (!cache.enabled()) {
+            MESSAGE("no program binary formats: skipped");
+            return;
+        }
+
+        auto built = cache.make_shader(vs_src, fs_src);
+        REQUIRE(built);
+        CHECK_EQ(cache.stats().misses, 1);
+        CHECK_EQ(cache.stats().stores, 1);
+
+        const auto key = cache.make_key({vs_src, fs_src});
+        auto loaded = cache.load(key);
+        REQUIRE(loaded);
+        CHECK_EQ(cache.stats().hits, 1);
+        GLint linked{0};
+        glGetProgramiv(loaded.id, GL_LINK_STATUS, &linked);
+        CHECK_NE(linked, 0);
+
+        const auto entry = std::filesystem::directory_iterator{dir}->path();
+
+        // truncated: the header claims more than the file holds
+        std::filesystem::resize_file(entry,
+                                     std::filesystem::file_size(entry) - 1);
+        CHECK_FALSE(cache.load(key));
+        CHECK_FALSE(std::filesystem::exists(entry));
+
+        // no entry: a plain miss
+        CHECK_FALSE(cache.load(key));
+        CHECK_EQ(cache.stats().misses, 3);
+
+        // garbage, shorter than a header
+        std::ofstream{entry, std::ios::binary} << "garbage";
+        CHECK_FALSE(cache.load(key));
+        CHECK_FALSE(std::filesystem::exists(entry));
+
+        tue::gfx::delete_shader(built);
+        tue::gfx::delete_shader(loaded);
+        std::filesystem::remove_all(dir);
+    }
+}
@@ -0,0 +1,126 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <tuesday/gfx/shader_compiler.hpp>
+
+#include "headless_gl.hpp"
+
+#include <chrono>
+#include <string_view>
+#include <thread>
+
+namespace {
+
+using tue::gfx::shader_job_status;
+
+constexpr std::string_view vs_src = R"(
+    #version 330 core
+    void main() { gl_Position = vec4(0.0, 0.0, 0.0, 1.0); }
+)";
+
+constexpr std::string_view fs_src = R"(
+    #version 330 core
+    out vec4 color;
+    void main() { color = vec4(1.0); }
+)";
+
+constexpr std::string_view fs_other_src = R"(
+    #version 330 core
+    out vec4 color;
+    void main() { color = vec4(0.5); }
+)";
+
+constexpr std::string_view fs_broken_src = R"(
+    #version 330 core
+    out vec4 color;
+    void main() { color = undeclared; }
+)";
+
+/// Polls as a loading loop would, until nothing is pending or 10 s pass.
+void poll_all(tue::gfx::shader_compiler &c) {
+    const auto until =
+        std::chrono::steady_clock::now() + std::chrono::seconds{10};
+    while (c.poll() != 0 && std::chrono::steady_clock::now() < until) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+}
+
+} // namespace
+
+TEST_SUITE("shader_compiler") {
+
+    TEST_CASE("batches finish through poll") {
+        headless_gl gl;
+        if (!gl) {
+            return;
+        }
+
+        tue::gfx::shader_compiler c;
+        const auto a = c.submit(vs_src, fs_src);
+        const auto b = c.submit(vs_src, fs_other_src);
+        const auto bad = c.submit(vs_src, fs_broken_src);
+        CHECK(a);
+        CHECK_NE(a.id, b.id);
+        CHECK_EQ(c.pending(), 3);
+        CHECK_EQ(c.status(a), shader_job_status::pending);
+
+        poll_all(c);
+        REQUIRE_EQ(c.pending(), 0);
+        CHECK_EQ(c.status(a), shader_job_status::ready);
+        CHECK_EQ(c.status(b), shader_job_status::ready);
+        CHECK_EQ(c.status(bad), shader_job_status::failed);
+
+        auto pa = c.take(a);
+        auto pb = c.take(b);
+        CHECK(pa);
+        CHECK(pb);
+        CHECK_NE(pa.id, pb.id);
+        CHECK_FALSE(c.take(bad));
+
+        // taken: forgotten, and a second take yields nothing
+        CHECK_EQ(c.status(a), shader_job_status::unknown);
+        CHECK_EQ(c.status(bad), shader_job_status::unknown);
+        CHECK_FALSE(c.take(a));
+
+        tue::gfx::delete_shader(pa);
+        tue::gfx::delete_shader(pb);
+    }
+
+    TEST_CASE("reused slots tell stale handles apart") {
+        headless_gl gl;
+        if (!gl) {
+            return;
+        }
+
+        tue::gfx::shader_compiler c;
+        const auto a = c.submit(vs_src, fs_src);
+        auto pa = c.take(a); // blocks: finalized right away
+        CHECK(pa);
+        CHECK_EQ(c.pending(), 0);
+
+        const auto b = c.submit(vs_src, fs_other_src);
+        CHECK_EQ(b.id, a.id);
+        CHECK_NE(b.gen, a.gen);
+        CHECK_EQ(c.status(a), shader_job_status::unknown);
+        CHECK_NE(c.status(b), shader_job_status::unknown);
+        CHECK_FALSE(c.take(a)); // must not take b's program
+
+        poll_all(c);
+        CHECK_EQ(c.status(b), shader_job_status::ready);
+        auto pb = c.take(b);
+        CHECK(pb);
+
+        // a fresh slot is only added while none is free
+        const auto d = c.submit(vs_src, fs_src);
+        const auto e = c.submit(vs_src, fs_src);
+        CHECK_EQ(d.id, a.id);
+        CHECK_NE(e.id, a.id);
+        c.wait_all();
+        CHECK_EQ(c.pending(), 0);
+        CHECK_EQ(c.status(d), shader_job_status::ready);
+        CHECK_EQ(c.status(e), shader_job_status::ready);
+
+        tue::gfx::delete_shader(pa);
+        tue::gfx::delete_shader(pb);
+    }
+}
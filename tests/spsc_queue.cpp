@@ -0,0 +1,60 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <tuesday/utility/spsc_queue.hpp>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+TEST_SUITE("spsc_queue") {
+
+    TEST_CASE("fifo and capacity") {
+        tue::spsc_queue<int, 4> q;
+        CHECK(q.empty_approx());
+
+        for (int i{0}; i < 4; ++i) {
+            REQUIRE(q.try_push(i));
+        }
+        CHECK_FALSE(q.try_push(4));
+        CHECK_EQ(q.size_approx(), 4);
+
+        int v{-1};
+        REQUIRE(q.try_pop(v));
+        CHECK_EQ(v, 0);
+        REQUIRE(q.try_push(4));
+
+        std::vector<int> rest;
+        CHECK_EQ(q.consume_all([&](int x) { rest.push_back(x); }), 4);
+        const std::vector<int> expected{1, 2, 3, 4};
+        CHECK_EQ(rest, expected);
+        CHECK(q.empty_approx());
+        CHECK_FALSE(q.try_pop(v));
+    }
+
+    TEST_CASE("two threads") {
+        constexpr std::uint64_t n = 1'000'000;
+        tue::spsc_queue<std::uint64_t, 256> q;
+
+        std::thread producer{[&] {
+            for (std::uint64_t i{0}; i < n;) {
+                if (q.try_push(i)) {
+                    ++i;
+                }
+            }
+        }};
+
+        std::uint64_t expected{0};
+        bool ordered{true};
+        while (expected < n) {
+            q.consume_all([&](std::uint64_t v) {
+                ordered = ordered && v == expected;
+                ++expected;
+            });
+        }
+        producer.join();
+
+        CHECK(ordered);
+        CHECK(q.empty_approx());
+    }
+}
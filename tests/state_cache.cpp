@@ -0,0 +1,128 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <tuesday/gfx/state_cache.hpp>
+
+#include "headless_gl.hpp"
+
+#include <array>
+
+namespace {
+
+using tue::gfx::state_cache;
+using tue::gfx::state_stats;
+
+/// Counters of the calls `f` makes on `sc`, as one frame.
+template <class F> state_stats frame_of(state_cache &sc, F &&f) {
+    sc.begin_frame();
+    f();
+    sc.begin_frame();
+    return sc.frame_stats();
+}
+
+GLuint binding(GLenum name) {
+    GLint id{0};
+    glGetIntegerv(name, &id);
+    return static_cast<GLuint>(id);
+}
+
+} // namespace
+
+TEST_SUITE("state_cache") {
+
+    TEST_CASE("tracked state reaches GL only when it changes") {
+        headless_gl gl;
+        if (!gl) {
+            return;
+        }
+
+        std::array<GLuint, 2> bufs{};
+        glCreateBuffers(2, bufs.data());
+        std::array<GLuint, 2> vaos{};
+        glCreateVertexArrays(2, vaos.data());
+
+        state_cache sc;
+
+        SUBCASE("repeated binds are filtered") {
+            const auto s = frame_of(sc, [&] {
+                sc.bind_buffer(GL_ARRAY_BUFFER, bufs[0]);
+                sc.bind_buffer(GL_ARRAY_BUFFER, bufs[0]);
+                sc.bind_buffer(GL_ARRAY_BUFFER, bufs[1]);
+                sc.depth_func(GL_LESS);
+                sc.depth_func(GL_LESS);
+            });
+            CHECK_EQ(s.calls, 5);
+            CHECK_EQ(s.filtered, 2);
+            CHECK_EQ(s.issued(), 3);
+            CHECK_EQ(binding(GL_ARRAY_BUFFER_BINDING), bufs[1]);
+
+            // after invalidate, the first call reaches GL again
+            sc.invalidate();
+            const auto t = frame_of(
+                sc, [&] { sc.bind_buffer(GL_ARRAY_BUFFER, bufs[1]); });
+            CHECK_EQ(t.issued(), 1);
+        }
+
+        SUBCASE("a vertex array change invalidates the element buffer") {
+            sc.bind_vertex_array(tue::gfx::vertex_array{vaos[0]});
+            sc.bind_buffer(GL_ELEMENT_ARRAY_BUFFER, bufs[0]);
+            const auto s = frame_of(sc, [&] {
+                sc.bind_vertex_array(tue::gfx::vertex_array{vaos[1]});
+                sc.bind_buffer(GL_ELEMENT_ARRAY_BUFFER, bufs[0]);
+            });
+            CHECK_EQ(s.filtered, 0);
+            CHECK_EQ(binding(GL_ELEMENT_ARRAY_BUFFER_BINDING), bufs[0]);
+        }
+
+        SUBCASE("forgotten objects are bound again") {
+            sc.bind_vertex_array(tue::gfx::vertex_array{vaos[0]});
+            sc.bind_buffer(GL_ARRAY_BUFFER, bufs[0]);
+            sc.bind_texture_unit(0, 0);
+            sc.forget_vertex_array(vaos[0]);
+            sc.forget_buffer(bufs[0]);
+            sc.forget_texture(0);
+            const auto s = frame_of(sc, [&] {
+                sc.bind_vertex_array(tue::gfx::vertex_array{vaos[0]});
+                sc.bind_buffer(GL_ARRAY_BUFFER, bufs[0]);
+                sc.bind_texture_unit(0, 0);
+            });
+            CHECK_EQ(s.calls, 3);
+            CHECK_EQ(s.filtered, 0);
+
+            // forgetting another name keeps the tracked one
+            sc.forget_buffer(bufs[1]);
+            const auto t = frame_of(
+                sc, [&] { sc.bind_buffer(GL_ARRAY_BUFFER, bufs[0]); });
+            CHECK_EQ(t.filtered, 1);
+        }
+
+        SUBCASE("indexed binds update the generic binding point") {
+            const auto s = frame_of(sc, [&] {
+                sc.bind_buffer_base(GL_UNIFORM_BUFFER, 1, bufs[0]);
+                sc.bind_buffer_base(GL_UNIFORM_BUFFER, 1, bufs[0]);
+                sc.bind_buffer(GL_UNIFORM_BUFFER, bufs[0]);
+            });
+            CHECK_EQ(s.calls, 3);
+            CHECK_EQ(s.filtered, 2);
+            CHECK_EQ(binding(GL_UNIFORM_BUFFER_BINDING), bufs[0]);
+        }
+
+        SUBCASE("untracked state is forwarded and counted as issued") {
+            const auto s = frame_of(sc, [&] {
+                sc.set_enabled(GL_STENCIL_TEST, false);
+                sc.set_enabled(GL_STENCIL_TEST, false);
+                sc.bind_buffer(GL_TEXTURE_BUFFER, bufs[0]);
+                sc.bind_buffer(GL_TEXTURE_BUFFER, bufs[0]);
+                sc.bind_buffer_base(GL_UNIFORM_BUFFER,
+                                    state_cache::max_indexed_buffers, 0);
+            });
+            CHECK_EQ(s.calls, 5);
+            CHECK_EQ(s.filtered, 0);
+            CHECK_EQ(s.issued(), 5);
+        }
+
+        glBindVertexArray(0);
+        glDeleteVertexArrays(2, vaos.data());
+        glDeleteBuffers(2, bufs.data());
+    }
+}
@@ -0,0 +1,65 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <tuesday/utility/triple_buffer.hpp>
+
+#include <array>
+#include <cstdint>
+#include <thread>
+
+TEST_SUITE("triple_buffer") {
+
+    TEST_CASE("latest value wins") {
+        tue::triple_buffer<int> b;
+        CHECK_FALSE(b.update());
+        CHECK_EQ(b.read_buffer(), 0);
+
+        b.write_buffer() = 1;
+        b.publish();
+        b.write_buffer() = 2;
+        b.publish();
+
+        REQUIRE(b.update());
+        CHECK_EQ(b.read_buffer(), 2);
+        CHECK_FALSE(b.update());
+        CHECK_EQ(b.read_buffer(), 2);
+
+        b.write_buffer() = 3;
+        b.publish();
+        REQUIRE(b.update());
+        CHECK_EQ(b.read_buffer(), 3);
+    }
+
+    TEST_CASE("snapshots are never torn") {
+        // every element of a published snapshot carries the same value
+        using snapshot = std::array<std::uint64_t, 64>;
+        constexpr std::uint64_t n = 200'000;
+        tue::triple_buffer<snapshot> b;
+
+        std::thread writer{[&] {
+            for (std::uint64_t i{1}; i <= n; ++i) {
+                b.write_buffer().fill(i);
+                b.publish();
+            }
+        }};
+
+        std::uint64_t last{0};
+        bool consistent{true};
+        bool monotonic{true};
+        while (last < n) {
+            if (!b.update()) {
+                continue;
+            }
+            const auto &s = b.read_buffer();
+            for (auto v : s) {
+                consistent = consistent && v == s[0];
+            }
+            monotonic = monotonic && s[0] > last;
+            last = s[0];
+        }
+        writer.join();
+
+        CHECK(consistent);
+        CHECK(monotonic);
+    }
+}
@@ -0,0 +1,106 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <tuesday/gfx/uniform_block.hpp>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+namespace {
+
+// vec3 + float share one 16-byte slot in std140
+struct block_vec3_float {
+    glm::vec3 dir;
+    float intensity;
+};
+
+// the second vec3 must start at 16, not 12
+struct block_vec3_vec3 {
+    glm::vec3 a;
+    glm::vec3 b;
+};
+
+struct block_vec3_vec3_padded {
+    glm::vec3 a;
+    float pad;
+    glm::vec3 b;
+    float pad2;
+};
+
+struct block_mixed {
+    glm::mat4 m;
+    std::array<glm::vec4, 2> colors;
+    float scale;
+};
+
+} // namespace
+
+template <> struct tue::gfx::std140_layout_fn<block_vec3_float> {
+    constexpr auto operator()() const noexcept {
+        return std::array{
+            TUE_STD140_MEMBER(block_vec3_float, dir),
+            TUE_STD140_MEMBER(block_vec3_float, intensity),
+        };
+    }
+};
+
+template <> struct tue::gfx::std140_layout_fn<block_vec3_vec3> {
+    constexpr auto operator()() const noexcept {
+        return std::array{
+            TUE_STD140_MEMBER(block_vec3_vec3, a),
+            TUE_STD140_MEMBER(block_vec3_vec3, b),
+        };
+    }
+};
+
+template <> struct tue::gfx::std140_layout_fn<block_vec3_vec3_padded> {
+    constexpr auto operator()() const noexcept {
+        return std::array{
+            TUE_STD140_MEMBER(block_vec3_vec3_padded, a),
+            TUE_STD140_MEMBER(block_vec3_vec3_padded, pad),
+            TUE_STD140_MEMBER(block_vec3_vec3_padded, b),
+            TUE_STD140_MEMBER(block_vec3_vec3_padded, pad2),
+        };
+    }
+};
+
+template <> struct tue::gfx::std140_layout_fn<block_mixed> {
+    constexpr auto operator()() const noexcept {
+        return std::array{
+            TUE_STD140_MEMBER(block_mixed, m),
+            TUE_STD140_MEMBER(block_mixed, colors),
+            TUE_STD140_MEMBER(block_mixed, scale),
+        };
+    }
+};
+
+namespace {
+
+using namespace tue::gfx;
+
+static_assert(is_std140_layout<block_vec3_float>());
+static_assert(!is_std140_layout<block_vec3_vec3>());
+static_assert(is_std140_layout<block_vec3_vec3_padded>());
+// `scale` ends at 148: the struct would need padding up to 160
+static_assert(!is_std140_layout<block_mixed>());
+
+static_assert(!std140_array_element<float>);
+static_assert(!std140_array_element<glm::vec3>);
+static_assert(std140_array_element<glm::vec4>);
+static_assert(std140_array_element<glm::mat4>);
+
+static_assert(std140_type_for<std::array<glm::vec4, 3>>.size == 48);
+
+} // namespace
+
+TEST_SUITE("uniform_block") {
+
+    TEST_CASE("std140 member offsets") {
+        constexpr auto l = std140_layout_for<block_vec3_float>;
+        CHECK(l[0].offset == 0);
+        CHECK(l[0].align == 16);
+        CHECK(l[1].offset == 12);
+        CHECK(l[1].size == 4);
+    }
+}
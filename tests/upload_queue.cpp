@@ -0,0 +1,129 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <tuesday/gfx/upload_queue.hpp>
+
+#include "headless_gl.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// Both modes run on a headless context standing in for the render one;
+// the threaded mode uploads on a second one. Skipped where none can be
+// created.
+
+namespace {
+
+template <class Elem>
+std::vector<Elem> read_back(const tue::gfx::uploaded_buffer &u) {
+    std::vector<Elem> v(static_cast<std::size_t>(u.count));
+    glGetNamedBufferSubData(u.id, 0,
+                            static_cast<GLsizeiptr>(v.size() * sizeof(Elem)),
+                            v.data());
+    return v;
+}
+
+} // namespace
+
+TEST_SUITE("upload_queue") {
+
+    TEST_CASE("inline uploads are handed over in ticket order") {
+        headless_gl gl;
+        if (!gl) {
+            return;
+        }
+
+        std::vector<tue::gfx::uploaded_buffer> got;
+        {
+            tue::gfx::upload_queue q;
+            CHECK_FALSE(q.threaded());
+            CHECK_EQ(q.in_flight(), 0);
+
+            const std::array<float, 6> a{1, 2, 3, 4, 5, 6};
+            const std::array<std::uint32_t, 2> b{7, 8};
+            const auto ta = q.upload(std::span{a});
+            const auto tb = q.upload(std::span{b});
+            CHECK_LT(ta, tb);
+            CHECK_EQ(q.in_flight(), 2);
+
+            const auto n = q.poll(
+                [&](const tue::gfx::uploaded_buffer &u) { got.push_back(u); });
+            CHECK_EQ(n, 2);
+            CHECK_EQ(q.in_flight(), 0);
+            CHECK_EQ(q.poll([](const auto &) {}), 0);
+
+            REQUIRE_EQ(got.size(), 2);
+            CHECK_EQ(got[0].ticket, ta);
+            CHECK_EQ(got[0].stride, sizeof(float));
+            CHECK_EQ(got[0].count, 6);
+            CHECK_EQ(got[1].ticket, tb);
+            CHECK_EQ(got[1].count, 2);
+            CHECK_NE(got[0].id, 0);
+
+            // not handed over: discarded by the destructor
+            const auto tc = q.upload(std::span{b});
+            CHECK_LT(tb, tc);
+            CHECK_EQ(q.in_flight(), 1);
+        }
+
+        // handed-over buffers belong to the caller
+        for (auto &u : got) {
+            glDeleteBuffers(1, &u.id);
+        }
+    }
+
+    TEST_CASE("threaded uploads arrive through fences, without blocking") {
+        headless_gl gl;
+        if (!gl) {
+            return;
+        }
+        auto worker = gl.ws.make_worker_context();
+        if (!worker) {
+            MESSAGE("no second headless GL context: skipped");
+            return;
+        }
+
+        std::vector<tue::gfx::uploaded_buffer> got;
+        std::vector<float> a(1000);
+        for (std::size_t i{0}; i < a.size(); ++i) {
+            a[i] = static_cast<float>(i);
+        }
+        const std::array<std::uint16_t, 3> b{7, 8, 9};
+        {
+            tue::gfx::upload_queue q{[&] { worker.make_current(); },
+                                     [&] { worker.release(); }};
+            CHECK(q.threaded());
+
+            // from a non-const vector as well as a const array
+            const auto ta = q.upload(std::span{a});
+            const auto tb = q.upload(std::span{b});
+            CHECK_LT(ta, tb);
+
+            // polls as a frame loop would, until both are handed over
+            const auto until =
+                std::chrono::steady_clock::now() + std::chrono::seconds{10};
+            while (got.size() < 2 && std::chrono::steady_clock::now() < until) {
+                q.poll([&](const tue::gfx::uploaded_buffer &u) {
+                    got.push_back(u);
+                });
+                std::this_thread::sleep_for(std::chrono::milliseconds{1});
+            }
+            CHECK_EQ(q.in_flight(), 0);
+        }
+
+        REQUIRE_EQ(got.size(), 2);
+        CHECK_EQ(got[0].ticket, 1);
+        CHECK_EQ(got[1].ticket, 2);
+        CHECK_EQ(got[1].stride, sizeof(std::uint16_t));
+        CHECK_EQ(read_back<float>(got[0]), a);
+        const auto rb = read_back<std::uint16_t>(got[1]);
+        CHECK_EQ(rb, std::vector<std::uint16_t>(b.begin(), b.end()));
+
+        for (auto &u : got) {
+            glDeleteBuffers(1, &u.id);
+        }
+    }
+}
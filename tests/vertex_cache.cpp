@@ -0,0 +1,77 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <tuesday/gfx/vertex_cache.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace {
+
+/// Two triangles per cell of a `n` x `n` grid, in random order.
+std::vector<std::uint32_t> shuffled_grid(std::uint32_t n) {
+    std::vector<std::array<std::uint32_t, 3>> tris;
+    const auto at = [n](std::uint32_t x, std::uint32_t y) {
+        return y * (n + 1) + x;
+    };
+    for (std::uint32_t y{0}; y < n; ++y) {
+        for (std::uint32_t x{0}; x < n; ++x) {
+            tris.push_back({at(x, y), at(x + 1, y), at(x + 1, y + 1)});
+            tris.push_back({at(x + 1, y + 1), at(x, y + 1), at(x, y)});
+        }
+    }
+    std::ranges::shuffle(tris, std::mt19937{42});
+
+    std::vector<std::uint32_t> out;
+    for (const auto &t : tris) {
+        out.insert(out.end(), t.begin(), t.end());
+    }
+    return out;
+}
+
+auto sorted_triangles(const std::vector<std::uint32_t> &is) {
+    std::vector<std::array<std::uint32_t, 3>> tris;
+    for (std::size_t i{0}; i < is.size(); i += 3) {
+        tris.push_back({is[i], is[i + 1], is[i + 2]});
+    }
+    std::ranges::sort(tris);
+    return tris;
+}
+
+} // namespace
+
+TEST_SUITE("vertex_cache") {
+
+    TEST_CASE("acmr bounds") {
+        const std::vector<std::uint32_t> one{0, 1, 2};
+        CHECK_EQ(tue::gfx::acmr(std::span{one}, 3), doctest::Approx(3.0));
+
+        // a strip-like fan reuses two vertices per triangle
+        const std::vector<std::uint32_t> fan{0, 1, 2, 0, 2, 3, 0, 3, 4};
+        CHECK_EQ(tue::gfx::acmr(std::span{fan}, 5), doctest::Approx(5.0 / 3));
+    }
+
+    TEST_CASE("optimization keeps triangles") {
+        auto is = shuffled_grid(16);
+        const auto before = sorted_triangles(is);
+        tue::gfx::optimize_vertex_cache(std::span{is}, 17 * 17);
+        CHECK(sorted_triangles(is) == before);
+    }
+
+    TEST_CASE("optimization reduces acmr") {
+        constexpr std::uint32_t n = 64;
+        constexpr std::size_t vertex_count = (n + 1) * (n + 1);
+
+        auto is = shuffled_grid(n);
+        const auto before = tue::gfx::acmr(std::span{is}, vertex_count);
+        tue::gfx::optimize_vertex_cache(std::span{is}, vertex_count);
+        const auto after = tue::gfx::acmr(std::span{is}, vertex_count);
+
+        MESSAGE("ACMR: ", before, " -> ", after);
+        CHECK_GT(before, 2.0);
+        CHECK_LT(after, 0.8);
+    }
+}
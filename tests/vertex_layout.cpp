@@ -0,0 +1,84 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <tuesday/gfx/vertex_layout.hpp>
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include <string_view>
+
+namespace {
+
+struct vertex_pnc {
+    glm::vec3 pos;
+    glm::vec3 normal;
+    glm::u8vec4 color;
+    glm::vec2 uv;
+};
+
+struct vertex_packed {
+    glm::vec3 pos;
+    glm::u8vec3 color;
+};
+
+constexpr std::string_view vs_source = R"(
+    #version 450
+    // layout (location = 7) in vec4 commented_out;
+    layout (location = 0) in vec3 vPos;
+    layout(location=1) in vec3 vNormal;
+    layout (location = 2) in vec4 vColor; /* u8vec4, normalized */
+    layout (location = 3) in vec2 vUV;
+
+    layout (std140, binding = 0) uniform Camera { mat4 MatP; };
+    layout (location = 0) out vec3 fPos;
+)";
+
+} // namespace
+
+TEST_SUITE("vertex_layout") {
+
+    TEST_CASE("interleaved offsets") {
+        constexpr auto layout = tue::gfx::vertex_layout_for<vertex_pnc>;
+        static_assert(layout.size() == 4);
+
+        static_assert(layout[0].index == 0 && layout[0].offset == 0);
+        static_assert(layout[1].index == 1 && layout[1].offset == 12);
+        static_assert(layout[2].index == 2 && layout[2].offset == 24);
+        static_assert(layout[3].index == 3 && layout[3].offset == 28);
+
+        static_assert(layout[2].attr.type == GL_UNSIGNED_BYTE);
+        static_assert(layout[2].attr.normalized == GL_TRUE);
+        static_assert(layout[3].attr.size == 2);
+
+        CHECK_EQ(layout[3].offset, offsetof(vertex_pnc, uv));
+    }
+
+    TEST_CASE("trailing padding") {
+        constexpr auto layout = tue::gfx::vertex_layout_for<vertex_packed>;
+        static_assert(layout.size() == 2);
+        static_assert(layout[1].offset == 12);
+        CHECK_EQ(sizeof(vertex_packed), 16);
+    }
+
+    TEST_CASE("glsl inputs") {
+        constexpr auto inputs = tue::gfx::parse_glsl_inputs(vs_source);
+        static_assert(inputs.size == 4);
+        static_assert(inputs.find(7) == nullptr);
+        static_assert(inputs.find(1)->type == "vec3");
+        static_assert(inputs.find(3)->name == "vUV");
+    }
+
+    TEST_CASE("layout matches shader") {
+        static_assert(tue::gfx::vertex_layout_matches<vertex_pnc>(vs_source));
+        // shifted locations no longer line up
+        static_assert(
+            !tue::gfx::vertex_layout_matches<vertex_pnc>(vs_source, 1));
+        // only component counts are checked: {vec3, u8vec3} fits vPos/vNormal
+        static_assert(
+            tue::gfx::vertex_layout_matches<vertex_packed>(vs_source));
+        // and the same at run time
+        CHECK(tue::gfx::vertex_layout_matches<vertex_pnc>(vs_source));
+        CHECK_FALSE(tue::gfx::vertex_layout_matches<vertex_pnc>(vs_source, 1));
+    }
+}
@@ -0,0 +1,97 @@
+#define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#include <doctest/doctest.h>
+
+#include <tuesday/gfx/vertex_pack.hpp>
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+TEST_SUITE("vertex_pack") {
+
+    TEST_CASE("half known values") {
+        static_assert(tue::gfx::float_to_half(0.F) == 0x0000);
+        static_assert(tue::gfx::float_to_half(-0.F) == 0x8000);
+        static_assert(tue::gfx::float_to_half(1.F) == 0x3C00);
+        static_assert(tue::gfx::float_to_half(-2.F) == 0xC000);
+        static_assert(tue::gfx::float_to_half(65504.F) == 0x7BFF);
+        static_assert(tue::gfx::float_to_half(65520.F) == 0x7C00);
+        static_assert(tue::gfx::float_to_half(0x1p-14F) == 0x0400);
+        static_assert(tue::gfx::float_to_half(0x1p-24F) == 0x0001);
+        static_assert(tue::gfx::float_to_half(0x1p-25F) == 0x0000);
+        // 1 + 2^-11 is a tie between 1 and 1 + 2^-10: rounds to even
+        static_assert(tue::gfx::float_to_half(1.F + 0x1p-11F) == 0x3C00);
+
+        CHECK_EQ(tue::gfx::float_to_half(
+                     std::numeric_limits<float>::infinity()),
+                 0x7C00);
+        CHECK(std::isnan(tue::gfx::half_to_float(tue::gfx::float_to_half(
+            std::numeric_limits<float>::quiet_NaN()))));
+    }
+
+    TEST_CASE("half round trip") {
+        // every finite half converts back to itself
+        for (std::uint32_t h{0}; h < 0x10000; ++h) {
+            if ((h & 0x7C00U) == 0x7C00U) {
+                continue;
+            }
+            const auto f = tue::gfx::half_to_float(std::uint16_t(h));
+            REQUIRE_EQ(tue::gfx::float_to_half(f), h);
+        }
+    }
+
+    TEST_CASE("bulk matches scalar") {
+        std::mt19937 rng{7};
+        std::uniform_real_distribution<float> dist{-2.F, 2.F};
+        std::vector<float> in(1003);
+        for (auto &f : in) {
+            f = dist(rng);
+        }
+        in[5] = std::numeric_limits<float>::quiet_NaN();
+
+        std::vector<std::uint16_t> halves(in.size());
+        tue::gfx::float_to_half(std::span<const float>{in},
+                                std::span{halves});
+        std::vector<std::int16_t> snorms(in.size());
+        tue::gfx::float_to_snorm16(std::span<const float>{in},
+                                   std::span{snorms});
+
+        for (std::size_t i{0}; i < in.size(); ++i) {
+            if (i != 5) {
+                REQUIRE_EQ(halves[i], tue::gfx::float_to_half(in[i]));
+            }
+            REQUIRE_EQ(snorms[i], tue::gfx::float_to_snorm16(in[i]));
+        }
+    }
+
+    TEST_CASE("snorm16") {
+        static_assert(tue::gfx::float_to_snorm16(1.F) == 32767);
+        static_assert(tue::gfx::float_to_snorm16(-1.F) == -32767);
+        static_assert(tue::gfx::float_to_snorm16(5.F) == 32767);
+        static_assert(tue::gfx::float_to_snorm16(0.F) == 0);
+        static_assert(tue::gfx::snorm16_to_float(-32768) == -1.F);
+
+        const auto v = tue::gfx::snorm16_to_float(
+            tue::gfx::float_to_snorm16(0.3F));
+        CHECK_LT(std::abs(v - 0.3F), 1.F / 32767);
+    }
+
+    TEST_CASE("2_10_10_10") {
+        constexpr auto p =
+            tue::gfx::pack_snorm_2_10_10_10(1.F, -1.F, 0.F, -1.F);
+        static_assert((p.bits & 0x3FFU) == 511);
+        static_assert(((p.bits >> 10) & 0x3FFU) == 0x201); // -511
+        static_assert(((p.bits >> 20) & 0x3FFU) == 0);
+        static_assert((p.bits >> 30) == 0x3); // -1
+
+        const auto u = tue::gfx::unpack_snorm_2_10_10_10(
+            tue::gfx::pack_snorm_2_10_10_10(0.25F, -0.5F, 0.75F, 1.F));
+        CHECK_LT(std::abs(u[0] - 0.25F), 1.F / 511);
+        CHECK_LT(std::abs(u[1] + 0.5F), 1.F / 511);
+        CHECK_LT(std::abs(u[2] - 0.75F), 1.F / 511);
+        CHECK_EQ(u[3], 1.F);
+    }
+}